@@ -1,27 +1,20 @@
 #include "LinkedList.hpp"
+#include "NodeReclaimer.hpp"
+#include "XorRelink.hpp"
 #include <memory>
 #include <utility>
 #include <cassert>
+#include <algorithm>
 #include <functional>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <unordered_set>
 #include <iostream>
 
 namespace
 {
-	template <class T>
-	Node<T>* find_previous(Node<T>* const start, Node<T>* const target)
-	{
-		intptr_t previous = 0;
-		auto current = start;
-		while (current != target)
-		{
-			Node<T>* tmp = current;
-			current = reinterpret_cast<Node<T>*>(previous ^ current->ptrdiff);
-			previous = reinterpret_cast<intptr_t>(tmp);
-		}
-
-		return reinterpret_cast<Node<T>*>(previous);
-	}
-	
 	template <class T>
 	Node<T>* get_next(const Node<T>* const previous, const intptr_t ptrdiff)
 	{
@@ -36,68 +29,122 @@ namespace
 		*previous = tmp;
 	}
 
-	template <class T, class Compare>
-	Node<T>* partition(
-		const Compare& comp,
-		Node<T>* const first,
-		Node<T>* const first_previous,
-		Node<T>* const last)
+	// detached chain of nodes, both ends link to null
+	template <class T>
+	struct Run
 	{
-		auto pivot = last->data;
-		auto i = first_previous;
-		auto i_previous = i == nullptr ? nullptr : get_next(first, first_previous->ptrdiff);
+		Node<T>* first;
+		Node<T>* last;
+	};
+
+	template <class T>
+	void append_node(Run<T>* const run, Node<T>* const node)
+	{
+		node->ptrdiff = reinterpret_cast<intptr_t>(run->last);
+		if (nullptr == run->last)
+		{
+			run->first = node;
+		}
+		else
+		{
+			run->last->ptrdiff ^= reinterpret_cast<intptr_t>(node);
+		}
+		run->last = node;
+	}
 
-		auto j = first;
-		auto j_previous = first_previous;
+	// stable merge of two sorted runs, the elements of a go first on ties
+	template <class T, class Compare>
+	Run<T> merge_runs(const Compare& comp, const Run<T>& a, const Run<T>& b)
+	{
+		Run<T> out = { nullptr, nullptr };
 
-		while (j != last)
+		Node<T>* a_previous = nullptr;
+		auto i = a.first;
+		Node<T>* b_previous = nullptr;
+		auto j = b.first;
+		while (nullptr != i && nullptr != j)
 		{
-			if (comp(j->data, pivot) || j->data == pivot)
+			// the taken node is relinked, but the next hop only reads the untaken node
+			if (comp(j->data, i->data))
 			{
-				if (nullptr == i)
-				{
-					i = first;
-					i_previous = first_previous;
-				}
-				else
-				{
-					do_next(&i_previous, &i);
-				}
-				std::swap(i->data, j->data);
+				auto node = j;
+				do_next(&b_previous, &j);
+				append_node(&out, node);
+			}
+			else
+			{
+				auto node = i;
+				do_next(&a_previous, &i);
+				append_node(&out, node);
 			}
-
-			do_next(&j_previous, &j);
 		}
 
-		if (nullptr == i)
+		// hook the rest of the unfinished run on in one step
+		auto rest = (nullptr != i) ? i : j;
+		auto rest_previous = (nullptr != i) ? a_previous : b_previous;
+		auto rest_last = (nullptr != i) ? a.last : b.last;
+		if (nullptr != rest)
 		{
-			i = first;
-			i_previous = first_previous;
+			rest->ptrdiff ^= reinterpret_cast<intptr_t>(rest_previous) ^ reinterpret_cast<intptr_t>(out.last);
+			out.last->ptrdiff ^= reinterpret_cast<intptr_t>(rest);
+			out.last = rest_last;
 		}
-		else
+
+		return out;
+	}
+
+	// node chain detached from a list, freed a slice at a time by NodeReclaimer
+	template <class T, class TNodeAllocator>
+	class RetiredNodes : public NodeReclaimer::Chain
+	{
+	public:
+		RetiredNodes(Node<T>* const _head, const TNodeAllocator& alloc)
+			: previous(nullptr)
+			, current(_head)
+			, allocator(alloc)
+		{}
+
+		~RetiredNodes() { reclaim(static_cast<std::size_t>(-1)); }
+
+		std::size_t reclaim(std::size_t budget) override
 		{
-			do_next(&i_previous, &i);
+			using traits = std::allocator_traits<TNodeAllocator>;
+
+			std::size_t freed = 0;
+			for (; freed < budget && nullptr != current; ++freed)
+			{
+				auto next = get_next(previous, current->ptrdiff);
+				previous = current;
+				traits::destroy(allocator, std::addressof(current->data));
+				traits::deallocate(allocator, current, 1);
+				current = next;
+			}
+			return freed;
 		}
-		std::swap(i->data, last->data);
 
-		return i;
-	}
+		bool empty() const noexcept override { return nullptr == current; }
+
+	private:
+		// previous is only used as an address to decode the next hop
+		Node<T>* previous;
+		Node<T>* current;
+		TNodeAllocator allocator;
+	};
 }
 
 
 template <class T, class TAllocator>
-LinkedList<T, TAllocator>::LinkedList(const std::size_t n, const_reference val, const node_allocator_type& alloc) : LinkedList(alloc)
+LinkedList<T, TAllocator>::LinkedList(const std::size_t n, const_reference val, const allocator_type& alloc) : LinkedList(alloc)
 {
-	for (std::size_t i = 0; i < n; ++i) { push_back(val); }
+	assign(n, val);
 }
 
 template <class T, class TAllocator>
 LinkedList<T, TAllocator>::LinkedList(const LinkedList<T, TAllocator>& other)
-	: head(other.head)
-	, tail(other.tail)
-	, _size(other._size)
-	, allocator(other.allocator)
-{}
+	: LinkedList(allocator_type(node_traits::select_on_container_copy_construction(other.allocator)))
+{
+	assign(other.begin(), other.end());
+}
 
 template <class T, class TAllocator>
 LinkedList<T, TAllocator>::LinkedList(LinkedList<T, TAllocator>&& other)
@@ -105,21 +152,52 @@ LinkedList<T, TAllocator>::LinkedList(LinkedList<T, TAllocator>&& other)
 	, tail(other.tail)
 	, _size(other._size)
 	, allocator(std::move(other.allocator))
+	, extras(nullptr)
 {
+	if (other.has_inline_nodes())
+	{
+		// inline nodes and the extras holding them stay with their owner
+		head = tail = nullptr;
+		_size = 0;
+		copy_settings(other);
+		splice(end(), other);
+		return;
+	}
+
+	// the node cache and a compact() block come along with the extras
+	std::swap(extras, other.extras);
 	other.head = other.tail = nullptr;
 	other._size = 0;
 }
 
 template <class T, class TAllocator>
-LinkedList<T, TAllocator>::~LinkedList() { clear(); }
+LinkedList<T, TAllocator>::~LinkedList()
+{
+	clear();
+	shrink_to_fit();
+	release_extras();
+}
 
 template <class T, class TAllocator>
 LinkedList<T, TAllocator>& LinkedList<T, TAllocator>::operator=(const LinkedList<T, TAllocator>& right)
 {
 	if (&right != this)
 	{
-		LinkedList<T, TAllocator> tmp(right);
-		swap(tmp);
+		// polymorphic allocators stay with the list they were given to
+		using propagate = typename node_traits::propagate_on_container_copy_assignment;
+		LinkedList<T, TAllocator> tmp(propagate::value ? right.get_allocator() : get_allocator());
+		tmp.assign(right.begin(), right.end());
+		if (has_inline_nodes())
+		{
+			swap(tmp);
+		}
+		else
+		{
+			// exchange hands tmp's extras over, so they carry this list's settings
+			tmp.copy_settings(*this);
+			swap_allocator(tmp, propagate());
+			exchange(tmp);
+		}
 	}
 
 	return *this;
@@ -144,7 +222,7 @@ ConstLinkedListIterator<T> ConstLinkedListIterator<T>::operator++(int)
 template <class T>
 ConstLinkedListIterator<T>& ConstLinkedListIterator<T>::operator--()
 {
-	assert(ptr != nullptr);
+	assert(previous != nullptr);
 	do_next(&ptr, &previous);
 	return *this;
 }
@@ -158,66 +236,338 @@ ConstLinkedListIterator<T> ConstLinkedListIterator<T>::operator--(int)
 }
 
 template <class T, class TAllocator>
-LinkedList<T, TAllocator>::LinkedList(const node_allocator_type& alloc)
+LinkedList<T, TAllocator>::LinkedList(const allocator_type& alloc)
 	: head(nullptr)
 	, tail(nullptr)
 	, _size(0)
 	, allocator(alloc)
+	, extras(nullptr)
 {}
 
+template <class T, class TAllocator>
+LinkedList<T, TAllocator>::LinkedList(ListExtras<T>* const embedded, Node<T>* const nodes, const size_type count,
+	const allocator_type& alloc)
+	: LinkedList(alloc)
+{
+	extras = embedded;
+	extras->inline_first = nodes;
+	extras->inline_last = nodes + count;
+	for (size_type i = count; i > 0; --i)
+	{
+		nodes[i - 1].ptrdiff = reinterpret_cast<intptr_t>(extras->inline_free);
+		extras->inline_free = nodes + (i - 1);
+	}
+}
+
 template <class T, class TAllocator>
 LinkedList<T, TAllocator>::LinkedList(std::initializer_list<value_type> il, const allocator_type& alloc)
 	: LinkedList<T, TAllocator>(alloc)
 {
-	for (auto it = il.begin(); it != il.end(); ++it)
+	assign(il.begin(), il.end());
+}
+
+template <class T, class TAllocator>
+void LinkedList<T, TAllocator>::swap(LinkedList<T, TAllocator>& other)
+{
+	using propagate = typename node_traits::propagate_on_container_swap;
+	if (has_inline_nodes() || other.has_inline_nodes() || (!propagate::value && !shares_allocator(other)))
 	{
-		auto node = create_node_in_tail();
-		node->data = *it;
+		// inline nodes can't change owner and neither can nodes of an allocator that stays,
+		// so move the elements through a plain list
+		LinkedList<T, TAllocator> tmp(get_allocator());
+		tmp.splice(tmp.end(), *this);
+		splice(end(), other);
+		other.splice(other.end(), tmp);
+		return;
 	}
+
+	swap_allocator(other, propagate());
+	exchange(other);
 }
 
 template <class T, class TAllocator>
-void LinkedList<T, TAllocator>::swap(LinkedList<T, TAllocator>& other)
+void LinkedList<T, TAllocator>::swap_allocator(LinkedList<T, TAllocator>& other, std::true_type) noexcept
+{
+	using std::swap;
+	swap(other.allocator, allocator);
+}
+
+template <class T, class TAllocator>
+void LinkedList<T, TAllocator>::exchange(LinkedList<T, TAllocator>& other) noexcept
 {
 	std::swap(other._size, _size);
-	std::swap(other.allocator, allocator);
 	std::swap(other.head, head);
 	std::swap(other.tail, tail);
+
+	// never called with inline nodes, so both extras are owned by their list
+	assert(!has_inline_nodes() && !other.has_inline_nodes());
+	std::swap(other.extras, extras);
 }
 
 template <class T, class TAllocator>
-void LinkedList<T, TAllocator>::push_back(const_reference data)
+void LinkedList<T, TAllocator>::push_back(const_reference data) { create_node_in_tail(data); }
+
+template <class T, class TAllocator>
+void LinkedList<T, TAllocator>::push_back(T&& data) { create_node_in_tail(std::move(data)); }
+
+template <class T, class TAllocator>
+void LinkedList<T, TAllocator>::push_front(const_reference data) { create_node_in_head(data); }
+
+template <class T, class TAllocator>
+void LinkedList<T, TAllocator>::push_front(T&& data) { create_node_in_head(std::move(data)); }
+
+template <class T, class TAllocator>
+template <class... Args>
+typename LinkedList<T, TAllocator>::reference LinkedList<T, TAllocator>::emplace_back(Args&&... args)
 {
-	auto node = create_node_in_tail();
-	node->data = data;
+	return create_node_in_tail(std::forward<Args>(args)...)->data;
 }
 
 template <class T, class TAllocator>
-void LinkedList<T, TAllocator>::push_back(T&& data)
+template <class... Args>
+typename LinkedList<T, TAllocator>::reference LinkedList<T, TAllocator>::emplace_front(Args&&... args)
 {
-	auto node = create_node_in_tail();
-	node->data = std::move(data);
+	return create_node_in_head(std::forward<Args>(args)...)->data;
 }
 
 template <class T, class TAllocator>
-void LinkedList<T, TAllocator>::push_front(const_reference data)
+template <class... Args>
+typename LinkedList<T, TAllocator>::iterator LinkedList<T, TAllocator>::emplace(const_iterator position, Args&&... args)
 {
-	auto node = create_node_in_head();
-	node->data = data;
+	auto node = create_node(std::forward<Args>(args)...);
+	insert_before(position.ptr, position.previous, node);
+	++_size;
+	return iterator(node, position.previous);
 }
 
 template <class T, class TAllocator>
-void LinkedList<T, TAllocator>::push_front(T&& data)
+void LinkedList<T, TAllocator>::pop_front()
 {
-	auto node = create_node_in_head();
-	node->data = std::move(data);
+	pop(&head);
+	settle_block();
 }
 
 template <class T, class TAllocator>
-void LinkedList<T, TAllocator>::pop_front() { pop(&head); }
+void LinkedList<T, TAllocator>::pop_back()
+{
+	pop(&tail);
+	settle_block();
+}
 
 template <class T, class TAllocator>
-void LinkedList<T, TAllocator>::pop_back() { pop(&tail); }
+LinkedList<T, TAllocator> LinkedList<T, TAllocator>::pop_front_n(size_type n)
+{
+	LinkedList<T, TAllocator> result(allocator);
+	if (n >= _size && !has_pinned_nodes())
+	{
+		result.head = head;
+		result.tail = tail;
+		result._size = _size;
+		head = tail = nullptr;
+		_size = 0;
+		return result;
+	}
+
+	Node<T>* previous = nullptr;
+	auto i = head;
+	for (size_type k = 0; k < n && nullptr != i; ++k)
+	{
+		do_next(&previous, &i);
+	}
+
+	if (has_pinned_nodes())
+	{
+		result.splice(result.end(), *this, begin(), const_iterator(i, previous));
+		return result;
+	}
+
+	if (nullptr == previous)
+	{
+		return result;
+	}
+
+	// cut the chain between previous and i
+	previous->ptrdiff ^= reinterpret_cast<intptr_t>(i);
+	i->ptrdiff ^= reinterpret_cast<intptr_t>(previous);
+
+	result.head = head;
+	result.tail = previous;
+	result._size = n;
+	head = i;
+	_size -= n;
+	return result;
+}
+
+template <class T, class TAllocator>
+LinkedList<T, TAllocator> LinkedList<T, TAllocator>::split_at(const_iterator position)
+{
+	size_type suffix_size = 0;
+	for (auto i = position; i != end(); ++i)
+	{
+		++suffix_size;
+	}
+	return split_at(position, suffix_size);
+}
+
+template <class T, class TAllocator>
+LinkedList<T, TAllocator> LinkedList<T, TAllocator>::split_at(const_iterator position, size_type suffix_size)
+{
+	LinkedList<T, TAllocator> result(get_allocator());
+	if (nullptr == position.ptr)
+	{
+		return result;
+	}
+
+	if (has_pinned_nodes())
+	{
+		result.splice(result.end(), *this, position, end());
+		return result;
+	}
+
+	assert(suffix_size > 0 && suffix_size <= _size);
+	auto previous = position.previous;
+	if (nullptr != previous)
+	{
+		previous->ptrdiff ^= reinterpret_cast<intptr_t>(position.ptr);
+		position.ptr->ptrdiff ^= reinterpret_cast<intptr_t>(previous);
+	}
+	else
+	{
+		head = nullptr;
+	}
+
+	result.head = position.ptr;
+	result.tail = tail;
+	result._size = suffix_size;
+	tail = previous;
+	_size -= suffix_size;
+	return result;
+}
+
+template <class T, class TAllocator>
+template <class Predicate>
+typename LinkedList<T, TAllocator>::iterator LinkedList<T, TAllocator>::stable_partition(Predicate pred)
+{
+	Run<T> taken = { nullptr, nullptr };
+	Run<T> rest = { nullptr, nullptr };
+
+	// the two runs one after the other
+	auto join = [&taken, &rest]() {
+		if (nullptr == taken.first)
+		{
+			return rest;
+		}
+		if (nullptr != rest.first)
+		{
+			taken.last->ptrdiff ^= reinterpret_cast<intptr_t>(rest.first);
+			rest.first->ptrdiff ^= reinterpret_cast<intptr_t>(taken.last);
+		}
+		return Run<T>{ taken.first, nullptr != rest.last ? rest.last : taken.last };
+	};
+
+	Node<T>* previous = nullptr;
+	auto i = head;
+	try
+	{
+		// the next hop only reads the unvisited node, which still links to the visited one
+		while (nullptr != i)
+		{
+			auto next = get_next(previous, i->ptrdiff);
+			append_node(pred(static_cast<const T&>(i->data)) ? &taken : &rest, i);
+			previous = i;
+			i = next;
+		}
+	}
+	catch (...)
+	{
+		// hook the unvisited nodes back on after both runs
+		auto done = join();
+		if (nullptr != done.last)
+		{
+			i->ptrdiff ^= reinterpret_cast<intptr_t>(previous) ^ reinterpret_cast<intptr_t>(done.last);
+			done.last->ptrdiff ^= reinterpret_cast<intptr_t>(i);
+			head = done.first;
+		}
+		throw;
+	}
+
+	auto second = rest.first;
+	auto second_previous = taken.last;
+	auto all = join();
+	head = all.first;
+	tail = all.last;
+	return iterator(second, second_previous);
+}
+
+template <class T, class TAllocator>
+LinkedList<T, TAllocator> LinkedList<T, TAllocator>::pop_back_n(size_type n)
+{
+	// reverse() is O(1), so the back is just the front of the reversed list
+	reverse();
+	auto result = pop_front_n(n);
+	reverse();
+	result.reverse();
+	return result;
+}
+
+template <class T, class TAllocator>
+template <class OutputIterator>
+OutputIterator LinkedList<T, TAllocator>::drain_into(OutputIterator out)
+{
+	auto i = head;
+	const auto last = tail;
+	const auto total = _size;
+	head = tail = nullptr;
+	_size = 0;
+
+	// drained nodes wait in [batch, i) and are freed relink_batch at a time;
+	// previous and batch_previous are only used as addresses to decode the next hop
+	Node<T>* previous = nullptr;
+	auto batch = i;
+	Node<T>* batch_previous = nullptr;
+	size_type pending = 0;
+	size_type drained = 0;
+	auto free_batch = [this, &batch, &batch_previous, &pending]() {
+		for (; pending > 0; --pending)
+		{
+			auto next = get_next(batch_previous, batch->ptrdiff);
+			batch_previous = batch;
+			release_node(batch);
+			batch = next;
+		}
+	};
+
+	try
+	{
+		while (nullptr != i)
+		{
+			*out = std::move(i->data);
+			++out;
+
+			auto next = get_next(previous, i->ptrdiff);
+			previous = i;
+			i = next;
+			++drained;
+			if (++pending == relink_batch)
+			{
+				free_batch();
+			}
+		}
+	}
+	catch (...)
+	{
+		// the undrained rest becomes the list again
+		free_batch();
+		i->ptrdiff ^= reinterpret_cast<intptr_t>(previous);
+		head = i;
+		tail = last;
+		_size = total - drained;
+		throw;
+	}
+
+	free_batch();
+	return out;
+}
 
 template <class T, class TAllocator>
 void LinkedList<T, TAllocator>::clear()
@@ -227,14 +577,24 @@ void LinkedList<T, TAllocator>::clear()
 		return;
 	}
 
+	// inline and block nodes are owned as a whole and always freed here
+	if (nullptr != get_reclaimer() && !has_pinned_nodes())
+	{
+		extras->reclaimer->retire(
+			std::unique_ptr<NodeReclaimer::Chain>(new RetiredNodes<T, node_allocator_type>(head, allocator)),
+			_size);
+		_size = 0;
+		head = tail = nullptr;
+		return;
+	}
+
 	Node<T>* previous = nullptr;
 	auto i = head;
 	while (nullptr != i)
 	{
 		auto next = get_next(previous, i->ptrdiff);
 		previous = i;
-		allocator.destroy(i);
-		allocator.deallocate(i, 1);
+		release_node(i);
 		i = next;
 	}
 	_size = 0;
@@ -242,43 +602,93 @@ void LinkedList<T, TAllocator>::clear()
 }
 
 template <class T, class TAllocator>
-Node<T>* LinkedList<T, TAllocator>::create_node_in_tail()
+void LinkedList<T, TAllocator>::discard() noexcept
 {
-	auto node = create_node();
-	if (tail != node)
+	static_assert(std::is_trivially_destructible<T>::value, "discard() skips the destructors");
+
+	// inline nodes have to go back on their free list
+	if (has_inline_nodes())
 	{
-        insert_after(tail, get_next(static_cast<Node<T>*>(nullptr), tail->ptrdiff), node);
+		clear();
+		return;
 	}
-	++_size;
 
-	return node;
+	head = tail = nullptr;
+	_size = 0;
+	release_extras();
 }
 
 template <class T, class TAllocator>
-Node<T>* LinkedList<T, TAllocator>::create_node()
+template <class... Args>
+Node<T>* LinkedList<T, TAllocator>::create_node_in_tail(Args&&... args)
 {
-	auto new_node = allocator.allocate(1);
-	allocator.construct(new_node);
+	auto node = create_node(std::forward<Args>(args)...);
+	insert_before(nullptr, tail, node);
+	++_size;
 
-	new_node->ptrdiff = 0;
+	return node;
+}
 
-	if (head == nullptr)
+template <class T, class TAllocator>
+template <class... Args>
+Node<T>* LinkedList<T, TAllocator>::create_node(Args&&... args)
+{
+	auto new_node = take_node();
+	try
+	{
+		node_traits::construct(allocator, std::addressof(new_node->data), std::forward<Args>(args)...);
+	}
+	catch (...)
 	{
-		head = new_node;
-		tail = head;
+		recycle_node(new_node);
+		throw;
 	}
 
+	new_node->ptrdiff = 0;
+
 	return new_node;
 }
 
 template <class T, class TAllocator>
-Node<T>* LinkedList<T, TAllocator>::create_node_in_head()
+Node<T>* LinkedList<T, TAllocator>::take_node()
 {
-	auto node = create_node();
-	if (head != node)
+	if (nullptr != extras)
 	{
-		insert_before(head, nullptr, node);
+		auto& s = *extras;
+		Node<T>* new_node = nullptr;
+		if (nullptr != s.inline_free)
+		{
+			new_node = s.inline_free;
+			s.inline_free = reinterpret_cast<Node<T>*>(new_node->ptrdiff);
+		}
+		else if (nullptr != s.block_free)
+		{
+			new_node = s.block_free;
+			s.block_free = reinterpret_cast<Node<T>*>(new_node->ptrdiff);
+			++s.block_live;
+		}
+		else if (nullptr != s.free_nodes)
+		{
+			new_node = s.free_nodes;
+			s.free_nodes = reinterpret_cast<Node<T>*>(new_node->ptrdiff);
+			--s.free_count;
+		}
+
+		if (nullptr != new_node)
+		{
+			return new_node;
+		}
 	}
+
+	return node_traits::allocate(allocator, 1);
+}
+
+template <class T, class TAllocator>
+template <class... Args>
+Node<T>* LinkedList<T, TAllocator>::create_node_in_head(Args&&... args)
+{
+	auto node = create_node(std::forward<Args>(args)...);
+	insert_before(head, nullptr, node);
 	++_size;
 
 	return node;
@@ -291,23 +701,398 @@ void LinkedList<T, TAllocator>::pop(Node<T>** const node)
 	assert(*node != nullptr);
 
 	--_size;
-	allocator.destroy(*node);
-	auto previous = get_next(static_cast<Node<T>*>(nullptr), (*node)->ptrdiff);
+	auto target = *node;
+	auto previous = get_next(static_cast<Node<T>*>(nullptr), target->ptrdiff);
 	if (nullptr == previous)
 	{
-		allocator.deallocate(*node, 1);
 		head = tail = nullptr;
+	}
+	else
+	{
+		previous->ptrdiff ^= reinterpret_cast<intptr_t>(target);
+		*node = previous;
+	}
+	release_node(target);
+}
+
+template <class T, class TAllocator>
+void LinkedList<T, TAllocator>::release_node(Node<T>* const node)
+{
+	node_traits::destroy(allocator, std::addressof(node->data));
+	recycle_node(node);
+}
+
+template <class T, class TAllocator>
+void LinkedList<T, TAllocator>::recycle_node(Node<T>* const node)
+{
+	if (nullptr != extras)
+	{
+		auto& s = *extras;
+		if (owns_inline(node))
+		{
+			node->ptrdiff = reinterpret_cast<intptr_t>(s.inline_free);
+			s.inline_free = node;
+			return;
+		}
+
+		if (owns_block(node))
+		{
+			node->ptrdiff = reinterpret_cast<intptr_t>(s.block_free);
+			s.block_free = node;
+			if (--s.block_live == 0)
+			{
+				release_block();
+			}
+			return;
+		}
+
+		if (s.free_count < s.free_capacity)
+		{
+			node->ptrdiff = reinterpret_cast<intptr_t>(s.free_nodes);
+			s.free_nodes = node;
+			++s.free_count;
+			return;
+		}
+	}
+
+	node_traits::deallocate(allocator, node, 1);
+}
+
+template <class T, class TAllocator>
+bool LinkedList<T, TAllocator>::owns_inline(const Node<T>* const node) const noexcept
+{
+	std::less<const Node<T>*> less;
+	return nullptr != extras && !less(node, extras->inline_first) && less(node, extras->inline_last);
+}
+
+template <class T, class TAllocator>
+bool LinkedList<T, TAllocator>::owns_block(const Node<T>* const node) const noexcept
+{
+	std::less<const Node<T>*> less;
+	return nullptr != extras && !less(node, extras->block_first) && less(node, extras->block_last);
+}
+
+template <class T, class TAllocator>
+void LinkedList<T, TAllocator>::release_block()
+{
+	auto& s = *extras;
+	node_traits::deallocate(allocator, s.block_first, static_cast<size_type>(s.block_last - s.block_first));
+	s.block_first = s.block_last = s.block_free = nullptr;
+	s.block_live = 0;
+}
+
+template <class T, class TAllocator>
+void LinkedList<T, TAllocator>::settle_block(Node<T>** const a, Node<T>** const b) noexcept
+{
+	if (nullptr == extras || nullptr == extras->block_first
+		|| extras->block_live * 4 >= static_cast<size_type>(extras->block_last - extras->block_first))
+	{
+		return;
+	}
+
+	relocate_block(a, b, std::is_nothrow_move_constructible<T>());
+}
+
+template <class T, class TAllocator>
+void LinkedList<T, TAllocator>::relocate_block(Node<T>** const a, Node<T>** const b, std::true_type) noexcept
+{
+	auto& s = *extras;
+
+	// every replacement node is taken up front, so running out of memory keeps the block
+	const auto block_free = s.block_free;
+	s.block_free = nullptr;
+	Node<T>* spare = nullptr;
+	try
+	{
+		for (size_type k = 0; k < s.block_live; ++k)
+		{
+			auto node = take_node();
+			node->ptrdiff = reinterpret_cast<intptr_t>(spare);
+			spare = node;
+		}
+	}
+	catch (...)
+	{
+		while (nullptr != spare)
+		{
+			auto next = reinterpret_cast<Node<T>*>(spare->ptrdiff);
+			recycle_node(spare);
+			spare = next;
+		}
+		s.block_free = block_free;
+		return;
+	}
+
+	Node<T>* previous = nullptr;
+	for (auto i = head; nullptr != i;)
+	{
+		auto next = get_next(previous, i->ptrdiff);
+		if (owns_block(i))
+		{
+			auto node = spare;
+			spare = reinterpret_cast<Node<T>*>(spare->ptrdiff);
+			node_traits::construct(allocator, std::addressof(node->data), std::move(i->data));
+			node_traits::destroy(allocator, std::addressof(i->data));
+
+			// the neighbours swap the old address for the new one in their links
+			node->ptrdiff = i->ptrdiff;
+			const auto moved = reinterpret_cast<intptr_t>(i) ^ reinterpret_cast<intptr_t>(node);
+			if (nullptr == previous)
+			{
+				head = node;
+			}
+			else
+			{
+				previous->ptrdiff ^= moved;
+			}
+			if (nullptr == next)
+			{
+				tail = node;
+			}
+			else
+			{
+				next->ptrdiff ^= moved;
+			}
+
+			for (auto kept : { a, b })
+			{
+				if (nullptr != kept && *kept == i)
+				{
+					*kept = node;
+				}
+			}
+			i = node;
+		}
+		previous = i;
+		i = next;
+	}
+
+	assert(nullptr == spare);
+	release_block();
+}
+
+template <class T, class TAllocator>
+ListExtras<T>& LinkedList<T, TAllocator>::side()
+{
+	if (nullptr == extras)
+	{
+		extras_allocator_type alloc(allocator);
+		auto created = extras_traits::allocate(alloc, 1);
+		extras_traits::construct(alloc, created);
+		extras = created;
+	}
+	return *extras;
+}
+
+template <class T, class TAllocator>
+void LinkedList<T, TAllocator>::release_extras() noexcept
+{
+	// extras holding inline nodes belong to the SmallXorList
+	if (nullptr == extras || has_inline_nodes())
+	{
 		return;
 	}
 
-	previous->ptrdiff ^= reinterpret_cast<intptr_t>(*node);
-	allocator.deallocate(*node, 1);
-	*node = previous;
+	extras_allocator_type alloc(allocator);
+	extras_traits::destroy(alloc, extras);
+	extras_traits::deallocate(alloc, extras, 1);
+	extras = nullptr;
+}
+
+template <class T, class TAllocator>
+void LinkedList<T, TAllocator>::copy_settings(const LinkedList& other)
+{
+	if (other.node_cache_capacity() != 0 || nullptr != other.get_reclaimer())
+	{
+		auto& s = side();
+		s.free_capacity = other.extras->free_capacity;
+		s.reclaimer = other.extras->reclaimer;
+	}
+}
+
+template <class T, class TAllocator>
+void LinkedList<T, TAllocator>::set_reclaimer(NodeReclaimer* const r)
+{
+	if (nullptr != extras || nullptr != r)
+	{
+		side().reclaimer = r;
+	}
+}
+
+template <class T, class TAllocator>
+void LinkedList<T, TAllocator>::compact()
+{
+	static_assert(std::is_move_constructible<T>::value, "compact() moves the elements into the block");
+
+	if (_size == 0)
+	{
+		return;
+	}
+
+	auto& s = side();
+	const auto n = _size;
+	auto block = node_traits::allocate(allocator, n);
+
+	// copy instead of move when moving could throw, so a failure leaves the list as it was
+	size_type k = 0;
+	Node<T>* previous = nullptr;
+	try
+	{
+		for (auto i = head; nullptr != i; do_next(&previous, &i), ++k)
+		{
+			node_traits::construct(allocator, std::addressof(block[k].data), std::move_if_noexcept(i->data));
+		}
+	}
+	catch (...)
+	{
+		while (k > 0)
+		{
+			node_traits::destroy(allocator, std::addressof(block[--k].data));
+		}
+		node_traits::deallocate(allocator, block, n);
+		throw;
+	}
+
+	// every old node goes, which also releases a previous block
+	previous = nullptr;
+	for (auto i = head; nullptr != i;)
+	{
+		auto next = get_next(previous, i->ptrdiff);
+		previous = i;
+		release_node(i);
+		i = next;
+	}
+	assert(nullptr == s.block_first);
+
+	head = tail = nullptr;
+	_size = 0;
+	intptr_t addresses[relink_batch + 2];
+	for (k = 0; k < n;)
+	{
+		size_type count = 0;
+		for (; count < relink_batch && k < n; ++count, ++k)
+		{
+			addresses[count + 1] = reinterpret_cast<intptr_t>(block + k);
+		}
+		link_run(tail, nullptr, addresses, count);
+	}
+
+	s.block_first = block;
+	s.block_last = block + n;
+	s.block_free = nullptr;
+	s.block_live = n;
+}
+
+template <class T, class TAllocator>
+double LinkedList<T, TAllocator>::average_link_distance() const noexcept
+{
+	if (_size < 2)
+	{
+		return 0;
+	}
+
+	double total = 0;
+	Node<T>* previous = nullptr;
+	for (auto i = head; nullptr != tail && i != tail;)
+	{
+		auto next = get_next(previous, i->ptrdiff);
+		auto distance = reinterpret_cast<intptr_t>(next) - reinterpret_cast<intptr_t>(i);
+		total += static_cast<double>(distance < 0 ? -distance : distance);
+		previous = i;
+		i = next;
+	}
+
+	return total / static_cast<double>(sizeof(Node<T>)) / static_cast<double>(_size - 1);
+}
+
+template <class T, class TAllocator>
+bool LinkedList<T, TAllocator>::shares_allocator(const LinkedList& x) const noexcept
+{
+	return node_traits::is_always_equal::value || allocator == x.allocator;
+}
+
+template <class T, class TAllocator>
+Node<T>* LinkedList<T, TAllocator>::adopt(LinkedList& x, Node<T>* const node)
+{
+	return adopt(x, node, std::is_move_constructible<T>());
+}
+
+template <class T, class TAllocator>
+Node<T>* LinkedList<T, TAllocator>::adopt(LinkedList& x, Node<T>* const node, std::true_type)
+{
+	if (!x.pins(node) && shares_allocator(x))
+	{
+		return node;
+	}
+
+	auto copy = create_node(std::move(node->data));
+	x.release_node(node);
+	return copy;
+}
+
+template <class T, class TAllocator>
+Node<T>* LinkedList<T, TAllocator>::adopt(LinkedList& x, Node<T>* const node, std::false_type)
+{
+	// without inline storage, compact() or differing allocators nothing is pinned
+	assert(!x.pins(node) && shares_allocator(x));
+	(void)x;
+	return node;
+}
+
+template <class T, class TAllocator>
+void LinkedList<T, TAllocator>::set_node_cache_capacity(size_type n)
+{
+	if (nullptr == extras && n == 0)
+	{
+		return;
+	}
+
+	auto& s = side();
+	s.free_capacity = n;
+	while (s.free_count > s.free_capacity)
+	{
+		auto node = s.free_nodes;
+		s.free_nodes = reinterpret_cast<Node<T>*>(node->ptrdiff);
+		node_traits::deallocate(allocator, node, 1);
+		--s.free_count;
+	}
+}
+
+template <class T, class TAllocator>
+typename LinkedList<T, TAllocator>::size_type LinkedList<T, TAllocator>::node_cache_capacity() const noexcept
+{
+	return nullptr != extras ? extras->free_capacity : 0;
+}
+
+template <class T, class TAllocator>
+typename LinkedList<T, TAllocator>::size_type LinkedList<T, TAllocator>::node_cache_size() const noexcept
+{
+	return nullptr != extras ? extras->free_count : 0;
+}
+
+template <class T, class TAllocator>
+void LinkedList<T, TAllocator>::shrink_to_fit()
+{
+	if (nullptr == extras)
+	{
+		return;
+	}
+
+	const auto capacity = extras->free_capacity;
+	set_node_cache_capacity(0);
+	extras->free_capacity = capacity;
 }
 
 template <class T, class TAllocator>
 void LinkedList<T, TAllocator>::insert_before(Node<T>* const pos, Node<T>* const previous, Node<T>* const node)
 {
+	if (head == nullptr)
+	{
+		node->ptrdiff = 0;
+		head = tail = node;
+		return;
+	}
+
 	if (pos == nullptr)
 	{
 		insert_after(tail, get_next(pos, tail->ptrdiff), node);
@@ -338,17 +1123,101 @@ void LinkedList<T, TAllocator>::insert_after(Node<T>* const pos, Node<T>* const
 	assert(node != nullptr);
 	assert(node != pos);
 
-	auto next = get_next(previous, pos->ptrdiff);
-	node->ptrdiff = reinterpret_cast<intptr_t>(pos) ^ reinterpret_cast<intptr_t>(next);
-	pos->ptrdiff = reinterpret_cast<intptr_t>(previous) ^ reinterpret_cast<intptr_t>(node);
-	if (nullptr != next)
-	{
-		next->ptrdiff ^= reinterpret_cast<intptr_t>(pos) ^ reinterpret_cast<intptr_t>(node);
-	}
+	auto next = get_next(previous, pos->ptrdiff);
+	node->ptrdiff = reinterpret_cast<intptr_t>(pos) ^ reinterpret_cast<intptr_t>(next);
+	pos->ptrdiff = reinterpret_cast<intptr_t>(previous) ^ reinterpret_cast<intptr_t>(node);
+	if (nullptr != next)
+	{
+		next->ptrdiff ^= reinterpret_cast<intptr_t>(pos) ^ reinterpret_cast<intptr_t>(node);
+	}
+
+	if (pos == tail)
+	{
+		tail = node;
+	}
+}
+
+template <class T, class TAllocator>
+void LinkedList<T, TAllocator>::link_run(Node<T>* const previous, Node<T>* const next, intptr_t* const addresses,
+	const size_type count) noexcept
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	auto first = reinterpret_cast<Node<T>*>(addresses[1]);
+	auto last = reinterpret_cast<Node<T>*>(addresses[count]);
+	addresses[0] = reinterpret_cast<intptr_t>(previous);
+	addresses[count + 1] = reinterpret_cast<intptr_t>(next);
+	const auto link_offset = static_cast<std::size_t>(
+		reinterpret_cast<char*>(&first->ptrdiff) - reinterpret_cast<char*>(first));
+	xor_relink(addresses, count, link_offset);
+
+	if (nullptr != previous)
+	{
+		previous->ptrdiff ^= reinterpret_cast<intptr_t>(next) ^ reinterpret_cast<intptr_t>(first);
+	}
+	else
+	{
+		head = first;
+	}
+
+	if (nullptr != next)
+	{
+		next->ptrdiff ^= reinterpret_cast<intptr_t>(previous) ^ reinterpret_cast<intptr_t>(last);
+	}
+	else
+	{
+		tail = last;
+	}
+
+	_size += count;
+}
+
+template <class T, class TAllocator>
+template <class Make>
+Node<T>* LinkedList<T, TAllocator>::insert_nodes(Node<T>* previous, Node<T>* const next, Make make)
+{
+	intptr_t addresses[relink_batch + 2];
+	Node<T>* first = nullptr;
+	for (;;)
+	{
+		size_type count = 0;
+		try
+		{
+			for (; count < relink_batch; ++count)
+			{
+				auto node = make();
+				if (nullptr == node)
+				{
+					break;
+				}
+				addresses[count + 1] = reinterpret_cast<intptr_t>(node);
+			}
+		}
+		catch (...)
+		{
+			// what was built stays in the list, as if inserted one by one
+			link_run(previous, next, addresses, count);
+			throw;
+		}
+
+		link_run(previous, next, addresses, count);
+		if (count == 0)
+		{
+			return first;
+		}
 
-	if (pos == tail)
-	{
-		tail = node;
+		if (nullptr == first)
+		{
+			first = reinterpret_cast<Node<T>*>(addresses[1]);
+		}
+		previous = reinterpret_cast<Node<T>*>(addresses[count]);
+		if (count < relink_batch)
+		{
+			return first;
+		}
 	}
 }
 
@@ -389,53 +1258,90 @@ template <class T, class TAllocator>
 template <class Compare>
 void LinkedList<T, TAllocator>::sort(Compare comp) noexcept
 {
-	Node<T>* null = nullptr;
-	sort_range(comp, head, null, tail, get_next(null, tail->ptrdiff));
-}
+	if (head == tail)
+	{
+		return;
+	}
 
-template <class T, class TAllocator>
-template <class Compare>
-void LinkedList<T, TAllocator>::sort_range(
-	const Compare& comp,
-	Node<T>* const first,
-	Node<T>* const first_previous,
-	Node<T>* const last,
-	Node<T>* const last_previous) noexcept
-{
-	auto last_next = (nullptr == last) ? nullptr : get_next(last_previous, last->ptrdiff);
-	if (last != nullptr && first != last && first != last_next)
+	// bins[i] holds a sorted run of 2^i nodes or nothing,
+	// 64 bins are enough for any list that fits in memory
+	Run<T> bins[64];
+	std::size_t used = 0;
+
+	while (nullptr != head)
 	{
-		auto p = partition(comp, first, first_previous, last);
-		auto p_previous = find_previous(head, p);
-		auto p_next = get_next(p_previous, p->ptrdiff);
-		auto p_previous_previous = (nullptr != p_previous) ? get_next(p, p_previous->ptrdiff) : nullptr;
+		Run<T> carry = { head, head };
+		auto next = get_next(static_cast<Node<T>*>(nullptr), head->ptrdiff);
+		if (nullptr != next)
+		{
+			next->ptrdiff ^= reinterpret_cast<intptr_t>(head);
+		}
+		head->ptrdiff = 0;
+		head = next;
+
+		// older bins hold earlier elements, merging them first keeps the sort stable
+		std::size_t i = 0;
+		for (; i < used && nullptr != bins[i].first; ++i)
+		{
+			carry = merge_runs(comp, bins[i], carry);
+			bins[i].first = nullptr;
+		}
+		bins[i] = carry;
+		if (i == used)
+		{
+			++used;
+		}
+	}
 
-		sort_range(comp, first, first_previous, p_previous, p_previous_previous);
-		sort_range(comp, p_next, p, last, last_previous);
+	Run<T> result = { nullptr, nullptr };
+	for (std::size_t i = 0; i < used; ++i)
+	{
+		if (nullptr != bins[i].first)
+		{
+			result = (nullptr == result.first) ? bins[i] : merge_runs(comp, bins[i], result);
+		}
 	}
+
+	head = result.first;
+	tail = result.last;
 }
 
 template <class T, class TAllocator>
 typename LinkedList<T, TAllocator>::iterator LinkedList<T, TAllocator>::insert(const_iterator position, const_reference val)
 {
-	auto node = create_node();
-	if (node != head)
+	return emplace(position, val);
+}
+
+template <class T, class TAllocator>
+typename LinkedList<T, TAllocator>::iterator LinkedList<T, TAllocator>::insert(const_iterator position, T&& val)
+{
+	return emplace(position, std::move(val));
+}
+
+template <class T, class TAllocator>
+typename LinkedList<T, TAllocator>::iterator LinkedList<T, TAllocator>::insert(const_iterator position, size_type n, const_reference val)
+{
+	if (n == 0)
 	{
-		insert_before(position.ptr, position.previous, node);
+		return iterator(position.ptr, position.previous);
 	}
-	node->data = val;
-	++_size;
-	return iterator(node, find_previous(head, node));
+
+	size_type made = 0;
+	auto first = insert_nodes(position.previous, position.ptr, [this, n, &val, &made]() -> Node<T>* {
+		return made++ < n ? create_node(val) : nullptr;
+	});
+
+	return iterator(first, position.previous);
 }
 
 template <class T, class TAllocator>
-template <class InputIterator>
+template <class InputIterator, class>
 typename LinkedList<T, TAllocator>::iterator LinkedList<T, TAllocator>::insert(
 	const_iterator position, InputIterator first, InputIterator last)
 {
 	for (auto i = first; i != last; ++i)
 	{
-		position = insert(position, *i);
+		position = emplace(position, *i);
 	}
 
 	return iterator(position.ptr, position.previous);
@@ -444,23 +1350,8 @@ typename LinkedList<T, TAllocator>::iterator LinkedList<T, TAllocator>::insert(
 template <class T, class TAllocator>
 void LinkedList<T, TAllocator>::reverse() noexcept
 {
-	Node<T>* const null = nullptr;
-	auto first = head;
-	Node<T>* first_previous = null;
-	auto last = tail;
-	Node<T>* last_previous = get_next(null, last->ptrdiff);
-
-	while (first != last && first != nullptr && get_next(first_previous, first->ptrdiff) != last)
-	{
-		std::swap(first->data, last->data);
-		do_next(&first_previous, &first);
-		do_next(&last, &last_previous);
-	}
-
-	if (first != nullptr && get_next(first_previous, first->ptrdiff) == last)
-	{
-		std::swap(first->data, last->data);
-	}
+	// XOR links read the same in both directions
+	std::swap(head, tail);
 }
 
 template <class T, class TAllocator>
@@ -469,29 +1360,12 @@ typename LinkedList<T, TAllocator>::iterator LinkedList<T, TAllocator>::erase(co
 	auto ptr = position.ptr;
 	assert(ptr != nullptr);
 
-	Node<T>* next = nullptr;
-	const Node<T>* null = nullptr;
-	if (head == ptr)
-	{
-		next = get_next(null, head->ptrdiff);
-		next->ptrdiff ^= reinterpret_cast<intptr_t>(head);
-		head = next;
-	}
-	else if (tail == ptr)
-	{
-		auto previous = get_next(null, tail->ptrdiff);
-		previous->ptrdiff ^= reinterpret_cast<intptr_t>(tail);
-		tail = previous;
-	}
-	else
-	{
-		next = unlink(ptr, find_previous(head, ptr));
-	}
-	allocator.destroy(ptr);
-	allocator.deallocate(ptr, 1);
+	auto next = unlink(ptr, position.previous);
+	release_node(ptr);
 	--_size;
 
-	return iterator(next, find_previous(head, next));
+	settle_block(&next, &position.previous);
+	return iterator(next, position.previous);
 }
 
 template <class T, class TAllocator>
@@ -505,10 +1379,29 @@ typename LinkedList<T, TAllocator>::iterator LinkedList<T, TAllocator>::erase(co
 
 	while (first != last)
 	{
-		first = erase(first);
+		auto next = unlink(first.ptr, first.previous);
+		release_node(first.ptr);
+		--_size;
+		first.ptr = next;
 	}
 
-	return iterator(last.ptr, last.previous);
+	// last.previous may be one of the erased nodes
+	settle_block(&first.ptr, &first.previous);
+	return iterator(first.ptr, first.previous);
+}
+
+template <class T, class TAllocator>
+void LinkedList<T, TAllocator>::resize(size_type n)
+{
+	auto made = _size;
+	insert_nodes(tail, nullptr, [this, n, &made]() -> Node<T>* {
+		return made++ < n ? create_node() : nullptr;
+	});
+
+	while (_size > n)
+	{
+		pop_back();
+	}
 }
 
 template <class T, class TAllocator>
@@ -516,10 +1409,7 @@ void LinkedList<T, TAllocator>::resize(size_type n, const_reference val)
 {
 	if (_size < n)
 	{
-		while (_size != n)
-		{
-			push_back(val);
-		}
+		insert(end(), n - _size, val);
 	}
 	else
 	{
@@ -531,24 +1421,26 @@ void LinkedList<T, TAllocator>::resize(size_type n, const_reference val)
 }
 
 template <class T, class TAllocator>
-template <class InputIterator>
+template <class InputIterator, class>
 void LinkedList<T, TAllocator>::assign(InputIterator first, InputIterator last)
 {
 	clear();
-	for (auto it = first; it != last; ++it)
-	{
-		push_back(*it);
-	}
+	insert_nodes(tail, nullptr, [this, &first, &last]() -> Node<T>* {
+		if (first == last)
+		{
+			return nullptr;
+		}
+		auto node = create_node(*first);
+		++first;
+		return node;
+	});
 }
 
 template <class T, class TAllocator>
 void LinkedList<T, TAllocator>::assign(size_type n, const_reference val)
 {
 	clear();
-	for (size_type i = 0; i < n; ++i)
-	{
-		push_back(val);
-	}
+	insert(end(), n, val);
 }
 
 template <class T, class TAllocator>
@@ -558,7 +1450,7 @@ void LinkedList<T, TAllocator>::assign(std::initializer_list<value_type> il)
 }
 
 template <class T, class TAllocator>
-void LinkedList<T, TAllocator>::splice(const_iterator position, LinkedList& x) noexcept
+void LinkedList<T, TAllocator>::splice(const_iterator position, LinkedList& x)
 {
 	if (this == &x || x.empty())
 	{
@@ -569,29 +1461,41 @@ void LinkedList<T, TAllocator>::splice(const_iterator position, LinkedList& x) n
 }
 
 template <class T, class TAllocator>
-void LinkedList<T, TAllocator>::splice(const_iterator position, LinkedList& x, const_iterator i) noexcept
+void LinkedList<T, TAllocator>::splice(const_iterator position, LinkedList& x, const_iterator i)
 {
 	auto target = i.ptr;
 	x.unlink(target, i.previous);
+	target = adopt(x, target);
 	insert_before(position.ptr, position.previous, target);
 	--x._size;
 	++_size;
+	x.settle_block();
+}
+
+template <class T, class TAllocator>
+void LinkedList<T, TAllocator>::splice(const_iterator position, LinkedList& x, const_iterator first, const_iterator last)
+{
+	splice_nodes(position, x, first, last);
 }
 
 template <class T, class TAllocator>
-void LinkedList<T, TAllocator>::splice(const_iterator position, LinkedList& x, const_iterator first, const_iterator last) noexcept
+Node<T>* LinkedList<T, TAllocator>::splice_nodes(const_iterator position, LinkedList& x, const_iterator first, const_iterator last)
 {
 	auto i = first.ptr;
 	auto i_previous = first.previous;
 	while (i != last.ptr)
 	{
 		auto next = x.unlink(i, i_previous);
-		insert_before(position.ptr, position.previous, i);
-		position.previous = i;
+		auto node = adopt(x, i);
+		insert_before(position.ptr, position.previous, node);
+		position.previous = node;
 		i = next;
 		--x._size;
 		++_size;
 	}
+
+	x.settle_block(&position.previous);
+	return position.previous;
 }
 
 template <class T, class TAllocator>
@@ -612,8 +1516,7 @@ void LinkedList<T, TAllocator>::unique(BinaryPredicate binary_pred)
 		while (next != nullptr && binary_pred(i->data, next->data))
 		{
 			unlink(next, i);
-            allocator.destroy(next);
-            allocator.deallocate(next, 1);
+			release_node(next);
 			--_size;
 			next = get_next(i_previous, i->ptrdiff);
 		}
@@ -624,14 +1527,125 @@ void LinkedList<T, TAllocator>::unique(BinaryPredicate binary_pred)
 			i = next;
 		}
 	}
+	settle_block();
 }
 
 template <class T, class TAllocator>
 void LinkedList<T, TAllocator>::unique() { unique(std::equal_to<T>()); }
 
+template <class T, class TAllocator>
+template <class Hash, class KeyEqual>
+typename LinkedList<T, TAllocator>::size_type LinkedList<T, TAllocator>::dedup_unordered(Hash hash, KeyEqual eq)
+{
+	if (_size < 2)
+	{
+		return 0;
+	}
+
+	auto hash_kept = [&hash](const T* const x) { return hash(*x); };
+	auto equal_kept = [&eq](const T* const x, const T* const y) { return eq(*x, *y); };
+	std::unordered_set<const T*, decltype(hash_kept), decltype(equal_kept)> kept(_size, hash_kept, equal_kept);
+
+	// removed nodes are chained through ptrdiff until a batch is full
+	Node<T>* removed = nullptr;
+	size_type removed_count = 0;
+	size_type total = 0;
+	auto free_removed = [this, &removed, &removed_count]() {
+		while (nullptr != removed)
+		{
+			auto next = reinterpret_cast<Node<T>*>(removed->ptrdiff);
+			release_node(removed);
+			removed = next;
+		}
+		removed_count = 0;
+	};
+
+	// previous is the last kept node, first and last the run of duplicates after it
+	// and next the node after the run; one relink closes the gap
+	Node<T>* previous = nullptr;
+	Node<T>* first = nullptr;
+	Node<T>* last = nullptr;
+	auto close_run = [this, &previous, &first, &last](Node<T>* const next) {
+		if (nullptr == previous)
+		{
+			head = next;
+		}
+		else
+		{
+			previous->ptrdiff ^= reinterpret_cast<intptr_t>(first) ^ reinterpret_cast<intptr_t>(next);
+		}
+		if (nullptr == next)
+		{
+			tail = previous;
+		}
+		else
+		{
+			next->ptrdiff ^= reinterpret_cast<intptr_t>(last) ^ reinterpret_cast<intptr_t>(previous);
+		}
+		first = last = nullptr;
+	};
+
+	auto i = head;
+	try
+	{
+		while (nullptr != i)
+		{
+			auto next = get_next(nullptr != last ? last : previous, i->ptrdiff);
+			if (kept.insert(std::addressof(i->data)).second)
+			{
+				if (nullptr != first)
+				{
+					close_run(i);
+				}
+				previous = i;
+			}
+			else
+			{
+				if (nullptr == first)
+				{
+					first = i;
+				}
+				last = i;
+				i->ptrdiff = reinterpret_cast<intptr_t>(removed);
+				removed = i;
+				--_size;
+				++total;
+				if (++removed_count == relink_batch)
+				{
+					free_removed();
+				}
+			}
+			i = next;
+		}
+	}
+	catch (...)
+	{
+		if (nullptr != first)
+		{
+			close_run(i);
+		}
+		free_removed();
+		throw;
+	}
+
+	if (nullptr != first)
+	{
+		close_run(nullptr);
+	}
+	free_removed();
+	settle_block();
+	return total;
+}
+
+template <class T, class TAllocator>
+typename LinkedList<T, TAllocator>::size_type LinkedList<T, TAllocator>::dedup_unordered()
+{
+	return dedup_unordered(std::hash<T>(), std::equal_to<T>());
+}
+
 template <class T, class TAllocator>
 template <class Compare>
-void LinkedList<T, TAllocator>::merge(LinkedList& x, Compare comp) noexcept
+void LinkedList<T, TAllocator>::merge(LinkedList& x, Compare comp)
 {
 	if (this == &x)
 	{
@@ -640,7 +1654,7 @@ void LinkedList<T, TAllocator>::merge(LinkedList& x, Compare comp) noexcept
 
 	if (empty())
 	{
-		swap(x);
+		splice(end(), x);
 		return;
 	}
 
@@ -660,8 +1674,9 @@ void LinkedList<T, TAllocator>::merge(LinkedList& x, Compare comp) noexcept
 		else
 		{
 			auto next = x.unlink(j, j_previous);
-			insert_before(i, i_previous, j);
-			i_previous = j;
+			auto node = adopt(x, j);
+			insert_before(i, i_previous, node);
+			i_previous = node;
 			j = next;
 			--x._size;
 			++_size;
@@ -672,13 +1687,12 @@ void LinkedList<T, TAllocator>::merge(LinkedList& x, Compare comp) noexcept
 	{
 		splice(const_iterator(i, i_previous), x, const_iterator(j, j_previous), x.end());
 	}
+	x.settle_block();
 }
 
 template <class T, class TAllocator>
-void LinkedList<T, TAllocator>::merge(LinkedList& x) noexcept { merge(x, std::less<T>()); }
+void LinkedList<T, TAllocator>::merge(LinkedList& x) { merge(x, std::less<T>()); }
 
-template <class T, class TAllocator>
-void LinkedList<T, TAllocator>::resize(size_type n) { resize(n, T()); }
 
 template <class T>
 ConstLinkedListIterator<T>& ConstLinkedListIterator<T>::operator=(const ConstLinkedListIterator<T>& other)
@@ -719,3 +1733,224 @@ typename LinkedList<T, TAllocator>::size_type LinkedList<T, TAllocator>::size()
 
 template <class T, class TAllocator>
 bool LinkedList<T, TAllocator>::empty() const noexcept { return _size == 0; }
+
+template <class T, class TAllocator>
+typename LinkedList<T, TAllocator>::cursor LinkedList<T, TAllocator>::make_cursor(const_iterator position) noexcept
+{
+	return cursor(this, position.ptr, position.previous);
+}
+
+template <class T, class TAllocator>
+LinkedListCursor<T, TAllocator>& LinkedListCursor<T, TAllocator>::operator++()
+{
+	assert(ptr != nullptr);
+	do_next(&previous, &ptr);
+	return *this;
+}
+
+template <class T, class TAllocator>
+LinkedListCursor<T, TAllocator>& LinkedListCursor<T, TAllocator>::operator--()
+{
+	assert(previous != nullptr);
+	do_next(&ptr, &previous);
+	return *this;
+}
+
+template <class T, class TAllocator>
+template <class U>
+void LinkedListCursor<T, TAllocator>::link_before(U&& val)
+{
+	auto node = list->create_node(std::forward<U>(val));
+	list->insert_before(ptr, previous, node);
+	++list->_size;
+	previous = node;
+}
+
+template <class T, class TAllocator>
+template <class U>
+void LinkedListCursor<T, TAllocator>::link_after(U&& val)
+{
+	assert(ptr != nullptr);
+
+	auto node = list->create_node(std::forward<U>(val));
+	list->insert_after(ptr, previous, node);
+	++list->_size;
+}
+
+template <class T, class TAllocator>
+void LinkedListCursor<T, TAllocator>::insert_before(const T& val) { link_before(val); }
+
+template <class T, class TAllocator>
+void LinkedListCursor<T, TAllocator>::insert_before(T&& val) { link_before(std::move(val)); }
+
+template <class T, class TAllocator>
+void LinkedListCursor<T, TAllocator>::insert_after(const T& val) { link_after(val); }
+
+template <class T, class TAllocator>
+void LinkedListCursor<T, TAllocator>::insert_after(T&& val) { link_after(std::move(val)); }
+
+template <class T, class TAllocator>
+void LinkedListCursor<T, TAllocator>::erase()
+{
+	assert(ptr != nullptr);
+
+	auto next = list->unlink(ptr, previous);
+	list->release_node(ptr);
+	--list->_size;
+	ptr = next;
+	list->settle_block(&ptr, &previous);
+}
+
+template <class T, class TAllocator>
+void LinkedListCursor<T, TAllocator>::splice_here(list_type& x)
+{
+	if (&x == list || x.empty())
+	{
+		return;
+	}
+
+	previous = list->splice_nodes(position(), x, x.begin(), x.end());
+}
+
+template <class T, class TAllocator>
+std::vector<typename LinkedList<T, TAllocator>::const_iterator> LinkedList<T, TAllocator>::split_points(size_type k) const
+{
+	std::vector<const_iterator> splits;
+	k = std::max<size_type>(1, std::min(k, _size));
+	splits.reserve(k + 1);
+	splits.push_back(begin());
+
+	// segment s ends after (s + 1) * size / k elements
+	Node<T>* previous = nullptr;
+	auto i = head;
+	size_type walked = 0;
+	for (size_type segment = 1; segment < k; ++segment)
+	{
+		for (auto stop = segment * _size / k; walked < stop; ++walked)
+		{
+			do_next(&previous, &i);
+		}
+		splits.push_back(const_iterator(i, previous));
+	}
+
+	splits.push_back(end());
+	return splits;
+}
+
+template <class T, class TAllocator>
+typename LinkedList<T, TAllocator>::size_type LinkedList<T, TAllocator>::segments_for(const ParallelPolicy& policy) const noexcept
+{
+	size_type threads = policy.threads != 0 ? policy.threads : std::thread::hardware_concurrency();
+	size_type by_size = _size / std::max<size_type>(1, policy.min_segment);
+	return std::max<size_type>(1, std::min(threads, by_size));
+}
+
+template <class T, class TAllocator>
+template <class Visit>
+void LinkedList<T, TAllocator>::run_segments(const std::vector<const_iterator>& splits, Visit visit)
+{
+	if (splits.size() < 2)
+	{
+		return;
+	}
+
+	std::exception_ptr failure;
+	std::mutex failure_mutex;
+	auto run = [&](const size_type segment) {
+		try
+		{
+			auto& first = splits[segment];
+			visit(segment, first.ptr, first.previous, splits[segment + 1].ptr);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(failure_mutex);
+			if (!failure)
+			{
+				failure = std::current_exception();
+			}
+		}
+	};
+
+	std::vector<std::thread> workers;
+	workers.reserve(splits.size() - 2);
+	for (size_type segment = 1; segment + 1 < splits.size(); ++segment)
+	{
+		workers.emplace_back(run, segment);
+	}
+	run(0);
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+
+	if (failure)
+	{
+		std::rethrow_exception(failure);
+	}
+}
+
+template <class T, class TAllocator>
+template <class F>
+void LinkedList<T, TAllocator>::parallel_for_each(const ParallelPolicy& policy, F f)
+{
+	parallel_for_each(split_points(segments_for(policy)), f);
+}
+
+template <class T, class TAllocator>
+template <class F>
+void LinkedList<T, TAllocator>::parallel_for_each(const std::vector<const_iterator>& splits, F f)
+{
+	run_segments(splits, [&f](size_type, Node<T>* i, Node<T>* previous, Node<T>* const last) {
+		while (i != last)
+		{
+			f(i->data);
+			do_next(&previous, &i);
+		}
+	});
+}
+
+template <class T, class TAllocator>
+template <class R, class Reduce, class Transform>
+R LinkedList<T, TAllocator>::parallel_transform_reduce(const ParallelPolicy& policy, R init, Reduce reduce, Transform transform) const
+{
+	return parallel_transform_reduce(split_points(segments_for(policy)), std::move(init), reduce, transform);
+}
+
+template <class T, class TAllocator>
+template <class R, class Reduce, class Transform>
+R LinkedList<T, TAllocator>::parallel_transform_reduce(const std::vector<const_iterator>& splits, R init, Reduce reduce,
+	Transform transform) const
+{
+	if (splits.size() < 2)
+	{
+		return init;
+	}
+
+	// every segment starts from its own first element, init joins once at the end
+	std::vector<std::unique_ptr<R>> partials(splits.size() - 1);
+	run_segments(splits, [&](const size_type segment, Node<T>* i, Node<T>* previous, Node<T>* const last) {
+		if (i == last)
+		{
+			return;
+		}
+
+		R partial = transform(static_cast<const T&>(i->data));
+		do_next(&previous, &i);
+		while (i != last)
+		{
+			partial = reduce(std::move(partial), transform(static_cast<const T&>(i->data)));
+			do_next(&previous, &i);
+		}
+		partials[segment].reset(new R(std::move(partial)));
+	});
+
+	for (auto& partial : partials)
+	{
+		if (partial)
+		{
+			init = reduce(std::move(init), std::move(*partial));
+		}
+	}
+	return init;
+}
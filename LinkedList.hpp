@@ -6,6 +6,17 @@
 #include <iterator>
 #include <initializer_list>
 #include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#if defined(__has_include)
+#if __has_include(<memory_resource>) && __cplusplus >= 201703L
+#define XOR_LIST_PMR 1
+#include <memory_resource>
+#endif
+#endif
+
+class NodeReclaimer;
 
 namespace
 {
@@ -19,11 +30,39 @@ namespace
 		T data;
 		intptr_t ptrdiff; /* XOR of next and previous node */
 	};
+
+	// state of the features most lists never use, allocated on first use
+	// so that a plain list is only its ends, its size and its allocator
+	template <class T>
+	struct ListExtras
+	{
+		Node<T>* free_nodes = nullptr; /* cached nodes chained through ptrdiff */
+		std::size_t free_count = 0;
+		std::size_t free_capacity = 0;
+
+		Node<T>* inline_first = nullptr; /* nodes inside a SmallXorList */
+		Node<T>* inline_last = nullptr;
+		Node<T>* inline_free = nullptr;
+
+		NodeReclaimer* reclaimer = nullptr;
+
+		Node<T>* block_first = nullptr; /* nodes allocated together by compact() */
+		Node<T>* block_last = nullptr;
+		Node<T>* block_free = nullptr;
+		std::size_t block_live = 0;
+	};
 }
 
 template < class T, class TAllocator = std::allocator<T> >
 class LinkedList;
 
+// how parallel_for_each and parallel_transform_reduce split a list
+struct ParallelPolicy
+{
+	std::size_t threads = 0; /* 0 for std::thread::hardware_concurrency() */
+	std::size_t min_segment = 4096; /* fewer elements per thread aren't worth a thread */
+};
+
 template <class T>
 class ConstLinkedListIterator : public std::iterator<std::bidirectional_iterator_tag, T>
 {
@@ -32,7 +71,8 @@ public:
 	using const_pointer = const T*;
 
 public:
-	friend LinkedList<T>;
+	template <class U, class TAllocator>
+	friend class LinkedList;
 
 	ConstLinkedListIterator()
 		: previous(nullptr)
@@ -62,8 +102,6 @@ public:
 	bool operator==(const ConstLinkedListIterator& rhs) { return ptr == rhs.ptr; }
 	bool operator!=(const ConstLinkedListIterator& rhs) { return !(*this == rhs); }
 
-	virtual ~ConstLinkedListIterator() {}
-
 protected:
 	Node<T>* previous;
 	Node<T>* ptr;
@@ -84,6 +122,69 @@ public:
     pointer operator->() { return &ConstLinkedListIterator<T>::ptr->data; }
 };
 
+/*
+	Editing position inside a LinkedList
+	Holds the same (previous, ptr) pair as an iterator but keeps it up to date
+	across its own edits, so a run of local edits never rescans the list
+
+	A cursor stays valid after any edit made through it
+	and after list edits that don't touch its node or the node right before it
+	Erasing either of those two nodes or inserting between them by other means
+	invalidates the cursor, like it does for iterators
+*/
+template <class T, class TAllocator>
+class LinkedListCursor
+{
+public:
+	using list_type = LinkedList<T, TAllocator>;
+	using iterator = LinkedListIterator<T>;
+	using reference = T&;
+	using pointer = T*;
+
+public:
+	reference operator*() { return ptr->data; }
+	pointer operator->() { return &ptr->data; }
+
+	LinkedListCursor& operator++();
+	LinkedListCursor& operator--();
+
+	bool at_end() const noexcept { return ptr == nullptr; }
+	iterator position() const noexcept { return iterator(ptr, previous); }
+
+	// the cursor keeps pointing to the same element
+	void insert_before(const T& val);
+	void insert_before(T&& val);
+
+	// the cursor must not be at the end
+	void insert_after(const T& val);
+	void insert_after(T&& val);
+
+	// the cursor moves to the next element
+	void erase();
+
+	// moves all elements of x before the cursor
+	void splice_here(list_type& x);
+
+private:
+	friend list_type;
+
+	LinkedListCursor(list_type* const _list, Node<T>* const _ptr, Node<T>* const _previous)
+		: list(_list)
+		, previous(_previous)
+		, ptr(_ptr)
+	{}
+
+	template <class U>
+	void link_before(U&& val);
+	template <class U>
+	void link_after(U&& val);
+
+private:
+	list_type* list;
+	Node<T>* previous;
+	Node<T>* ptr;
+};
+
 template <class T, class TAllocator>
 class LinkedList
 {
@@ -100,15 +201,22 @@ public:
 
 	using iterator = LinkedListIterator<T>;
 	using const_iterator = ConstLinkedListIterator<T>;
+	using cursor = LinkedListCursor<T, TAllocator>;
+
+private:
+	// range overloads only take iterators, so insert(pos, 3, 7) picks the count overload as in std::list
+	template <class InputIterator>
+	using RequireInputIterator = typename std::enable_if<std::is_convertible<
+		typename std::iterator_traits<InputIterator>::iterator_category, std::input_iterator_tag>::value>::type;
 
 public:
-	LinkedList() : LinkedList(node_allocator_type()) {}
-	explicit LinkedList(const node_allocator_type& alloc);
+	LinkedList() : LinkedList(allocator_type()) {}
+	explicit LinkedList(const allocator_type& alloc);
 
 	LinkedList(std::initializer_list<value_type> il, const allocator_type& alloc = allocator_type());
 
-	explicit LinkedList(const std::size_t n, const node_allocator_type& alloc = allocator_type()) : LinkedList(n, T()) {}
-	LinkedList(const std::size_t n, const_reference val, const node_allocator_type& alloc = allocator_type());
+	explicit LinkedList(const std::size_t n, const allocator_type& alloc = allocator_type()) : LinkedList(alloc) { resize(n); }
+	LinkedList(const std::size_t n, const_reference val, const allocator_type& alloc = allocator_type());
 
 	LinkedList(const LinkedList<T, TAllocator>& other);
 	LinkedList(LinkedList<T, TAllocator>&& other);
@@ -117,22 +225,62 @@ public:
 
 	LinkedList& operator=(const LinkedList<T, TAllocator>& right);
 
+	// swaps the nodes when the allocators propagate on swap or compare equal, the elements otherwise
 	void swap(LinkedList<T, TAllocator>& other);
 
+	allocator_type get_allocator() const { return allocator_type(allocator); }
+
 	void push_back(const_reference data);
 	void push_back(T&& data);
 
 	void push_front(const_reference data);
 	void push_front(T&& data);
 
+	// elements are constructed in place, T needs neither a default constructor nor a copy
+	template <class... Args>
+	reference emplace_back(Args&&... args);
+
+	template <class... Args>
+	reference emplace_front(Args&&... args);
+
+	template <class... Args>
+	iterator emplace(const_iterator position, Args&&... args);
+
 	void pop_front();
 	void pop_back();
 
+	// detach up to n nodes from one end as a new list in a single walk
+	// nodes of inline storage or of a compact() block are copied out instead
+	LinkedList pop_front_n(size_type n);
+	LinkedList pop_back_n(size_type n);
+
+	// cuts the list before position and returns [position, end()) as a new list
+	// O(1) when the length of the suffix is passed, otherwise the suffix is counted
+	// nodes of inline storage or of a compact() block are copied out instead
+	LinkedList split_at(const_iterator position);
+	LinkedList split_at(const_iterator position, size_type suffix_size);
+
+	// moves the elements satisfying pred before the others, keeping the order within both groups
+	// nodes are relinked in one pass, nothing is moved or allocated
+	// returns the first element of the second group; if pred throws the list stays whole
+	template <class Predicate>
+	iterator stable_partition(Predicate pred);
+
+	// moves every element to out in order; the chain is detached once and its nodes
+	// are freed in batches during the walk; if out throws the rest stays in the list
+	template <class OutputIterator>
+	OutputIterator drain_into(OutputIterator out);
+
 	size_type size() const noexcept;
 	bool empty() const noexcept;
 
 	void clear();
 
+	// forgets every node without destroying or freeing it, for lists on an arena
+	// that is about to be released as a whole; T must be trivially destructible
+	// the node cache capacity and the reclaimer, kept on the arena too, are reset
+	void discard() noexcept;
+
 	reference back() noexcept;
 	const_reference back() const noexcept;
 
@@ -145,70 +293,219 @@ public:
 	iterator end() noexcept;
 	const_iterator end() const noexcept;
 
+	cursor make_cursor(const_iterator position) noexcept;
+
+	// up to k + 1 boundaries of segments of about equal length, found in one walk;
+	// the first is begin(), the last end(), they stay valid as long as iterators do
+	// and can be reused by the parallel algorithms below
+	std::vector<const_iterator> split_points(size_type k) const;
+
+	// calls f on every element, segments run on their own threads, the first on the caller's
+	// the first exception thrown by f is rethrown once all segments have stopped
+	template <class F>
+	void parallel_for_each(const ParallelPolicy& policy, F f);
+	template <class F>
+	void parallel_for_each(const std::vector<const_iterator>& splits, F f);
+
+	// reduce(init, transform(x)...) in some order, so reduce has to be associative and commutative
+	template <class R, class Reduce, class Transform>
+	R parallel_transform_reduce(const ParallelPolicy& policy, R init, Reduce reduce, Transform transform) const;
+	template <class R, class Reduce, class Transform>
+	R parallel_transform_reduce(const std::vector<const_iterator>& splits, R init, Reduce reduce, Transform transform) const;
+
+	// stable merge sort that relinks nodes, needs no memory beyond a fixed array on the stack
+	// invalidates iterators
 	void sort() noexcept;
 
 	template <class Compare>
 	void sort(Compare comp) noexcept;
 
-	template <class Compare>
-	void sort_range(
-		const Compare& comp,
-		Node<T>* const first,
-		Node<T>* const first_previous,
-		Node<T>* const last,
-		Node<T>* const last_previous) noexcept;
-	
-	
 	iterator insert(const_iterator position, const_reference val);
+	iterator insert(const_iterator position, T&& val);
 
-	template <class InputIterator>
+	// returns the first inserted element, or position if n is 0
+	iterator insert(const_iterator position, size_type n, const_reference val);
+
+	// each element goes before the previously inserted one, so the range ends up reversed
+	// elements are constructed from *i, pass move iterators to move them
+	template <class InputIterator, class = RequireInputIterator<InputIterator>>
 	iterator insert(const_iterator position, InputIterator first, InputIterator last);
 	
+	// O(1): only the ends are swapped, the XOR links read the same both ways
+	// unlike std::list::reverse this invalidates every iterator, end() included:
+	// an old iterator keeps stepping in the old direction
 	void reverse() noexcept;
 	
 	iterator erase(const_iterator position);
 	iterator erase(const_iterator first, const_iterator last);
 	
+	// new elements are value-initialized in place
 	void resize(size_type n);
 	void resize(size_type n, const_reference val);
 
-	template <class InputIterator>
+	template <class InputIterator, class = RequireInputIterator<InputIterator>>
 	void assign(InputIterator first, InputIterator last);
 
 	void assign(size_type n, const_reference val);
 	void assign(std::initializer_list<value_type> il);
 
-	void splice(const_iterator position, LinkedList& x) noexcept;
-	void splice(const_iterator position, LinkedList& x, const_iterator i) noexcept;
-	void splice(const_iterator position, LinkedList& x, const_iterator first, const_iterator last) noexcept;
+	// splicing nodes out of a list with inline storage (see SmallXorList)
+	// or out of a compact() block moves their elements into freshly created nodes:
+	// that allocates, can throw and invalidates references to those elements
+	void splice(const_iterator position, LinkedList& x);
+	void splice(const_iterator position, LinkedList& x, const_iterator i);
+	void splice(const_iterator position, LinkedList& x, const_iterator first, const_iterator last);
 	
 	template <class BinaryPredicate>
 	void unique(BinaryPredicate binary_pred);
 	void unique();
+
+	// removes every element equal to an earlier one, wherever it is, and keeps the first
+	// occurrences in order; one pass with a hash set of the kept elements
+	// each run of removed nodes is unlinked with one relink and the nodes are freed in batches
+	// returns how many elements were removed; if hash or eq throws the list stays valid
+	template <class Hash, class KeyEqual>
+	size_type dedup_unordered(Hash hash, KeyEqual eq);
+	size_type dedup_unordered();
 	
 	template <class Compare>
-	void merge(LinkedList& x, Compare comp) noexcept;
-	void merge(LinkedList& x) noexcept;
+	void merge(LinkedList& x, Compare comp);
+	void merge(LinkedList& x);
+
+	// released nodes are kept for reuse by the next insertion
+	// instead of going back to the allocator, up to the given number of nodes
+	// off by default: a cached node stays with the list until it is destroyed
+	// like the reclaimer, the capacity belongs to the list object: copies start
+	// without it and assignment keeps the target's own, only a move takes it along
+	void set_node_cache_capacity(size_type n);
+	size_type node_cache_capacity() const noexcept;
+	size_type node_cache_size() const noexcept;
+
+	// returns every cached node to the allocator
+	void shrink_to_fit();
+
+	// with a reclaimer set, clear() and the destructor hand the node chain over in O(1)
+	// instead of freeing it, see NodeReclaimer
+	void set_reclaimer(NodeReclaimer* const r);
+	NodeReclaimer* get_reclaimer() const noexcept { return nullptr != extras ? extras->reclaimer : nullptr; }
+
+	// moves the elements, in list order, into one freshly allocated block of nodes
+	// and frees the old nodes; freed block nodes are reused first by later insertions
+	// and the block goes back to the allocator once none of its nodes is in use
+	// invalidates iterators
+	// block nodes are pinned to this list: splice, merge, split_at and pop_front_n/pop_back_n
+	// move their elements into new nodes instead of relinking them, in linear time
+	// once fewer than a quarter of the block's nodes are in use, the next removal moves
+	// the survivors into nodes of their own and frees the block, invalidating iterators
+	// and references to them; T has to be nothrow move constructible for that
+	void compact();
+
+	// mean distance between neighbours, in nodes: 1 right after compact(),
+	// grows as churn scatters nodes over the heap
+	double average_link_distance() const noexcept;
+
+	static constexpr size_type default_node_cache_capacity = 0;
 
 private:
+	friend cursor;
+
+protected:
+	// nodes in [nodes, nodes + count) are served before the allocator
+	// and never handed to it; the storage and embedded must outlive the list
+	LinkedList(ListExtras<T>* const embedded, Node<T>* const nodes, const size_type count, const allocator_type& alloc);
+
+private:
+	using node_traits = std::allocator_traits<node_allocator_type>;
+	using extras_allocator_type = typename std::allocator_traits<TAllocator>::template rebind_alloc< ListExtras<T> >;
+	using extras_traits = std::allocator_traits<extras_allocator_type>;
+
 	Node<T>* head;
 	Node<T>* tail;
 	size_type _size;
 
 	node_allocator_type allocator;
 
+	ListExtras<T>* extras; /* owned unless it has inline nodes, then it lives in the SmallXorList */
+
 private:
-	Node<T>* create_node();
+	template <class... Args>
+	Node<T>* create_node(Args&&... args);
+	Node<T>* take_node();
+	void recycle_node(Node<T>* const node);
+	void release_node(Node<T>* const node);
+	bool owns_inline(const Node<T>* const node) const noexcept;
+	bool owns_block(const Node<T>* const node) const noexcept;
+
+	// the extras, allocated through the list's allocator if the list has none yet
+	ListExtras<T>& side();
+	void release_extras() noexcept;
+	bool has_inline_nodes() const noexcept { return nullptr != extras && nullptr != extras->inline_first; }
+	// node cache capacity and reclaimer, handed over by moves and kept by assignment
+	void copy_settings(const LinkedList& other);
+
+	// pinned nodes live in storage the list owns as a whole and can't be handed to another list
+	bool pins(const Node<T>* const node) const noexcept { return owns_inline(node) || owns_block(node); }
+	bool has_pinned_nodes() const noexcept
+	{
+		return nullptr != extras && (nullptr != extras->inline_first || nullptr != extras->block_first);
+	}
+	void release_block();
+
+	// frees a block that is mostly unused after moving its live nodes out,
+	// called once a removal is done; the given positions follow their node
+	void settle_block(Node<T>** const a = nullptr, Node<T>** const b = nullptr) noexcept;
+	void relocate_block(Node<T>** const a, Node<T>** const b, std::true_type) noexcept;
+	void relocate_block(Node<T>**, Node<T>**, std::false_type) noexcept {}
+
+	// nodes may move between lists only when one allocator can free what the other allocated
+	bool shares_allocator(const LinkedList& x) const noexcept;
+	void exchange(LinkedList& other) noexcept; /* everything but the allocators */
+	void swap_allocator(LinkedList& other, std::true_type) noexcept;
+	void swap_allocator(LinkedList&, std::false_type) noexcept {}
+
+	size_type segments_for(const ParallelPolicy& policy) const noexcept;
+
+	// runs visit(segment, first, previous, last) for every segment between neighbouring splits
+	template <class Visit>
+	static void run_segments(const std::vector<const_iterator>& splits, Visit visit);
+	// node as it can be linked into this list, moved into a new node when x pins it;
+	// elements that can't be moved are only ever relinked
+	Node<T>* adopt(LinkedList& x, Node<T>* const node);
+	Node<T>* adopt(LinkedList& x, Node<T>* const node, std::true_type);
+	Node<T>* adopt(LinkedList& x, Node<T>* const node, std::false_type);
+	Node<T>* splice_nodes(const_iterator position, LinkedList& x, const_iterator first, const_iterator last);
 
 	void insert_before(Node<T>* const pos, Node<T>* const previous, Node<T>* const node);
 	void insert_after(Node<T>* const pos, Node<T>* const previous, Node<T>* const node);
 	Node<T>* unlink(Node<T>* const pos, Node<T>* const previous);
 
-	Node<T>* create_node_in_tail();
-	Node<T>* create_node_in_head();
+	// nodes built in a row are linked in batches of relink_batch with one xor_relink pass
+	static constexpr size_type relink_batch = 64;
+
+	// links addresses[1..count] in order between previous and next,
+	// addresses[0] and addresses[count + 1] are filled in here
+	void link_run(Node<T>* const previous, Node<T>* const next, intptr_t* const addresses, const size_type count) noexcept;
+
+	// links the nodes make() returns between previous and next until it returns nullptr
+	// returns the first node linked, nullptr if there was none
+	template <class Make>
+	Node<T>* insert_nodes(Node<T>* previous, Node<T>* const next, Make make);
+
+	template <class... Args>
+	Node<T>* create_node_in_tail(Args&&... args);
+	template <class... Args>
+	Node<T>* create_node_in_head(Args&&... args);
 	void pop(Node<T>** const node);
 };
 
+#ifdef XOR_LIST_PMR
+namespace pmr
+{
+	template <class T>
+	using LinkedList = ::LinkedList<T, std::pmr::polymorphic_allocator<T>>;
+}
+#endif
+
 #include "LinkedList-inl.hpp"
 
 #endif /* _LINKED_LIST_H_ */
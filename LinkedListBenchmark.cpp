@@ -0,0 +1,754 @@
+#include "LinkedListBenchmark.hpp"
+#include "NodePool.hpp"
+#include "NodeReclaimer.hpp"
+#include "RcuXorList.hpp"
+#include "XorChannel.hpp"
+#include "XorLinkedHashMap.hpp"
+#include "XorRelink.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <list>
+#include <random>
+#include <shared_mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/perf_event.h>)
+#define BENCHMARK_PERF_COUNTERS 1
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#endif
+
+namespace
+{
+	using benchmark_clock = std::chrono::steady_clock;
+
+	double elapsed_ns(const benchmark_clock::time_point& start, const benchmark_clock::time_point& finish)
+	{
+		return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(finish - start).count());
+	}
+
+	// counts the bytes a container asks for, headers of the underlying malloc not included
+	std::size_t counted_bytes = 0;
+
+	template <class T>
+	struct CountingAllocator
+	{
+		using value_type = T;
+
+		CountingAllocator() = default;
+		template <class U>
+		CountingAllocator(const CountingAllocator<U>&) {}
+
+		T* allocate(const std::size_t n)
+		{
+			counted_bytes += n * sizeof(T);
+			return std::allocator<T>().allocate(n);
+		}
+
+		void deallocate(T* const p, const std::size_t n)
+		{
+			counted_bytes -= n * sizeof(T);
+			std::allocator<T>().deallocate(p, n);
+		}
+
+		template <class U>
+		bool operator==(const CountingAllocator<U>&) const { return true; }
+		template <class U>
+		bool operator!=(const CountingAllocator<U>&) const { return false; }
+	};
+
+	struct Msg
+	{
+		std::uint64_t id;
+		std::uint64_t payload[3];
+	};
+
+	// every thread keeps many short session lists, half of which it hands to the next thread
+	// so a good share of nodes is freed on a thread that didn't allocate them
+	template <class Allocator>
+	double session_churn(const std::size_t threads)
+	{
+		using Session = LinkedList<Msg, Allocator>;
+		const std::size_t sessions = 2000;
+		const std::size_t rounds = 200;
+
+		std::vector<std::vector<Session>> handoff(threads);
+		for (auto& lists : handoff)
+		{
+			lists.resize(sessions);
+		}
+
+		auto start = benchmark_clock::now();
+		std::vector<std::thread> workers;
+		for (std::size_t t = 0; t < threads; ++t)
+		{
+			workers.emplace_back([t, threads, sessions, rounds, &handoff] {
+				std::vector<Session> mine(sessions);
+
+				for (std::size_t r = 0; r < rounds; ++r)
+				{
+					for (std::size_t s = 0; s < sessions; ++s)
+					{
+						auto& session = mine[s];
+						session.push_back(Msg{ r, { s, t, 0 } });
+						if (session.size() > 4)
+						{
+							session.pop_front();
+						}
+					}
+				}
+
+				// the next thread destroys these nodes
+				auto& out = handoff[(t + 1) % threads];
+				for (std::size_t s = 0; s < sessions; s += 2)
+				{
+					out[s].splice(out[s].end(), mine[s]);
+				}
+			});
+		}
+		for (auto& worker : workers)
+		{
+			worker.join();
+		}
+
+		// frees from a thread that allocated nothing
+		handoff.clear();
+		return elapsed_ns(start, benchmark_clock::now()) / 1e6;
+	}
+
+	// dTLB load misses of the calling thread, read() is -1 when perf counters are not available
+	class TlbMissCounter
+	{
+	public:
+		TlbMissCounter()
+		{
+#if BENCHMARK_PERF_COUNTERS
+			perf_event_attr attr{};
+			attr.size = sizeof(attr);
+			attr.type = PERF_TYPE_HW_CACHE;
+			attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+		}
+
+		TlbMissCounter(const TlbMissCounter&) = delete;
+		TlbMissCounter& operator=(const TlbMissCounter&) = delete;
+
+		~TlbMissCounter()
+		{
+#if BENCHMARK_PERF_COUNTERS
+			if (fd >= 0)
+			{
+				::close(fd);
+			}
+#endif
+		}
+
+		void start()
+		{
+#if BENCHMARK_PERF_COUNTERS
+			if (fd >= 0)
+			{
+				::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+				::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+			}
+#endif
+		}
+
+		long long read()
+		{
+#if BENCHMARK_PERF_COUNTERS
+			long long count = 0;
+			if (fd >= 0)
+			{
+				::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+				if (::read(fd, &count, sizeof(count)) == sizeof(count))
+				{
+					return count;
+				}
+			}
+#endif
+			return -1;
+		}
+
+	private:
+		int fd = -1;
+	};
+
+	void print_percentiles(const char* name, std::vector<double>& samples)
+	{
+		std::sort(samples.begin(), samples.end());
+		auto at = [&samples](double q) { return samples[static_cast<std::size_t>(q * (samples.size() - 1))]; };
+		std::cout << name
+			<< ": p50 " << at(0.5)
+			<< " ns, p99 " << at(0.99)
+			<< " ns, p99.9 " << at(0.999)
+			<< " ns, max " << samples.back() << " ns" << std::endl;
+	}
+}
+
+void LinkedListBenchmark::run()
+{
+	queue_churn_benchmark();
+	channel_benchmark();
+	node_pool_benchmark();
+	deferred_clear_benchmark();
+	compact_benchmark();
+	lru_benchmark();
+	relink_benchmark();
+	pmr_benchmark();
+	parallel_benchmark();
+	rcu_benchmark();
+	huge_page_benchmark();
+}
+
+void LinkedListBenchmark::queue_churn_benchmark()
+{
+	// steady push_back/pop_front cycle over a short queue, timed in batches
+	const std::size_t samples = 100000;
+	const std::size_t batch = 16;
+	const std::size_t depth = 64;
+
+	const LinkedList<int>::size_type capacities[] = { 0, 32 };
+	for (auto capacity : capacities)
+	{
+		LinkedList<int> queue;
+		queue.set_node_cache_capacity(capacity);
+		for (std::size_t i = 0; i < depth; ++i)
+		{
+			queue.push_back(static_cast<int>(i));
+		}
+
+		std::vector<double> timings;
+		timings.reserve(samples);
+		for (std::size_t s = 0; s < samples; ++s)
+		{
+			auto start = benchmark_clock::now();
+			for (std::size_t i = 0; i < batch; ++i)
+			{
+				queue.push_back(static_cast<int>(i));
+				queue.pop_front();
+			}
+			timings.push_back(elapsed_ns(start, benchmark_clock::now()) / batch);
+		}
+
+		print_percentiles(capacity == 0 ? "queue churn, no node cache" : "queue churn, node cache", timings);
+	}
+}
+
+void LinkedListBenchmark::channel_benchmark()
+{
+	// one producer stamps items, one consumer measures queueing latency
+	const std::size_t items = 1000000;
+	const std::size_t batches[] = { 1, 64 };
+	using stamp = benchmark_clock::rep;
+
+	for (auto batch : batches)
+	{
+		XorChannel<stamp> channel(1024);
+		std::vector<double> latencies;
+		latencies.reserve(items);
+
+		auto start = benchmark_clock::now();
+		std::thread producer([&channel, items] {
+			for (std::size_t i = 0; i < items; ++i)
+			{
+				channel.push(benchmark_clock::now().time_since_epoch().count());
+			}
+			channel.close();
+		});
+
+		for (;;)
+		{
+			auto received = channel.pop_n(batch);
+			if (received.empty())
+			{
+				break;
+			}
+
+			auto now = benchmark_clock::now().time_since_epoch().count();
+			for (auto sent : received)
+			{
+				latencies.push_back(static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+					benchmark_clock::duration(now - sent)).count()));
+			}
+		}
+		producer.join();
+
+		auto seconds = elapsed_ns(start, benchmark_clock::now()) / 1e9;
+		std::cout << "channel, pop_n(" << batch << "): " << static_cast<double>(items) / seconds / 1e6 << " M items/s" << std::endl;
+		print_percentiles("channel latency", latencies);
+	}
+}
+
+void LinkedListBenchmark::node_pool_benchmark()
+{
+	const std::size_t thread_counts[] = { 1, 2, 4, 8 };
+	for (auto threads : thread_counts)
+	{
+		auto plain = session_churn<std::allocator<Msg>>(threads);
+		auto pooled = session_churn<PoolAllocator<Msg>>(threads);
+		std::cout << "session churn, " << threads << " threads: std::allocator " << plain
+			<< " ms, PoolAllocator " << pooled << " ms" << std::endl;
+	}
+}
+
+void LinkedListBenchmark::deferred_clear_benchmark()
+{
+	// time the clear() call a request would wait for
+	const std::size_t n = 5000000;
+	const char* modes[] = { "synchronous", "deferred, reclaim(budget)", "deferred, background thread" };
+
+	for (std::size_t mode = 0; mode < 3; ++mode)
+	{
+		NodeReclaimer reclaimer;
+		if (mode == 2)
+		{
+			reclaimer.start();
+		}
+
+		LinkedList<int> list;
+		for (std::size_t i = 0; i < n; ++i)
+		{
+			list.push_back(static_cast<int>(i));
+		}
+		if (mode != 0)
+		{
+			list.set_reclaimer(&reclaimer);
+		}
+
+		auto start = benchmark_clock::now();
+		list.clear();
+		auto ms = elapsed_ns(start, benchmark_clock::now()) / 1e6;
+
+		// the slices a request loop would pay for afterwards
+		std::vector<double> slices;
+		for (;;)
+		{
+			auto slice_start = benchmark_clock::now();
+			if (reclaimer.reclaim(65536) == 0)
+			{
+				break;
+			}
+			slices.push_back(elapsed_ns(slice_start, benchmark_clock::now()) / 1e6);
+		}
+
+		std::cout << "clear() of " << n << " nodes, " << modes[mode] << ": " << ms << " ms";
+		if (mode == 1 && !slices.empty())
+		{
+			std::cout << ", then " << slices.size() << " reclaim(65536) slices of ~" << slices[slices.size() / 2] << " ms";
+		}
+		std::cout << std::endl;
+	}
+}
+
+void LinkedListBenchmark::compact_benchmark()
+{
+	// sorting random values leaves neighbours all over the heap
+	const std::size_t n = 2000000;
+	std::mt19937 random(42);
+	LinkedList<std::uint64_t> list;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		list.push_back(random());
+	}
+	list.sort();
+
+	auto traverse = [&list] {
+		std::uint64_t sum = 0;
+		auto start = benchmark_clock::now();
+		for (const auto v : list)
+		{
+			sum += v;
+		}
+		auto ns = elapsed_ns(start, benchmark_clock::now()) / static_cast<double>(list.size());
+		return sum != 0 ? ns : 0;
+	};
+
+	std::cout << "traversal of " << n << " sorted nodes: " << traverse() << " ns/hop, link distance "
+		<< list.average_link_distance() << std::endl;
+
+	auto start = benchmark_clock::now();
+	list.compact();
+	auto ms = elapsed_ns(start, benchmark_clock::now()) / 1e6;
+
+	std::cout << "compact(): " << ms << " ms, then " << traverse() << " ns/hop, link distance "
+		<< list.average_link_distance() << std::endl;
+}
+
+void LinkedListBenchmark::lru_benchmark()
+{
+	// get or put with a capacity of a tenth of the key space
+	const std::size_t capacity = 100000;
+	const std::size_t operations = 4000000;
+	std::vector<std::uint64_t> keys(operations);
+	std::mt19937_64 random(7);
+	for (auto& key : keys)
+	{
+		// mostly hits on a hot tenth, misses on the rest
+		key = (random() % 4 != 0) ? random() % capacity : random() % (capacity * 10);
+	}
+
+	{
+		counted_bytes = 0;
+		XorLinkedHashMap<std::uint64_t, std::uint64_t, std::hash<std::uint64_t>, std::equal_to<std::uint64_t>,
+			CountingAllocator<std::pair<const std::uint64_t, std::uint64_t>>> cache;
+		cache.reserve(capacity);
+		const auto buckets = counted_bytes;
+
+		auto start = benchmark_clock::now();
+		for (auto key : keys)
+		{
+			if (nullptr == cache.get(key))
+			{
+				if (cache.size() == capacity)
+				{
+					cache.evict_back();
+				}
+				cache.put(key, key);
+			}
+		}
+		auto ns = elapsed_ns(start, benchmark_clock::now()) / static_cast<double>(operations);
+		// the links sit in the map node, so an entry is one allocation instead of a map node and a list node
+		std::cout << "LRU, XorLinkedHashMap: " << ns << " ns/op, "
+			<< static_cast<double>(counted_bytes - buckets) / static_cast<double>(cache.size()) << " bytes/entry" << std::endl;
+	}
+
+	{
+		counted_bytes = 0;
+		using Order = std::list<std::pair<std::uint64_t, std::uint64_t>, CountingAllocator<std::pair<std::uint64_t, std::uint64_t>>>;
+		Order order;
+		std::unordered_map<std::uint64_t, Order::iterator, std::hash<std::uint64_t>, std::equal_to<std::uint64_t>,
+			CountingAllocator<std::pair<const std::uint64_t, Order::iterator>>> index;
+		index.reserve(capacity);
+		const auto buckets = counted_bytes;
+
+		auto start = benchmark_clock::now();
+		for (auto key : keys)
+		{
+			auto found = index.find(key);
+			if (found != index.end())
+			{
+				order.splice(order.begin(), order, found->second);
+				continue;
+			}
+
+			if (index.size() == capacity)
+			{
+				index.erase(order.back().first);
+				order.pop_back();
+			}
+			order.emplace_front(key, key);
+			index.emplace(key, order.begin());
+		}
+		auto ns = elapsed_ns(start, benchmark_clock::now()) / static_cast<double>(operations);
+		std::cout << "LRU, std::list + std::unordered_map: " << ns << " ns/op, "
+			<< static_cast<double>(counted_bytes - buckets) / static_cast<double>(index.size()) << " bytes/entry" << std::endl;
+	}
+}
+
+void LinkedListBenchmark::relink_benchmark()
+{
+	// the node-at-a-time loop against the xor_relink this build enables
+	struct Slot { std::uint64_t data; intptr_t link; };
+	const std::size_t n = 1000000;
+	const int rounds = 20;
+	std::vector<Slot> nodes(n);
+	std::vector<intptr_t> addresses(n + 2, 0);
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		addresses[i + 1] = reinterpret_cast<intptr_t>(&nodes[i]);
+	}
+
+	auto time = [&](void (*relink)(const intptr_t*, std::size_t, std::size_t)) {
+		auto start = benchmark_clock::now();
+		for (int r = 0; r < rounds; ++r)
+		{
+			relink(addresses.data(), n, offsetof(Slot, link));
+		}
+		return elapsed_ns(start, benchmark_clock::now()) / static_cast<double>(n * rounds);
+	};
+
+	const char* kernel =
+#if defined(__AVX512F__)
+		"AVX-512";
+#elif defined(__AVX2__)
+		"AVX2";
+#else
+		"scalar";
+#endif
+	// in address order like after compact(), then shuffled like after churn
+	for (const char* order : { "sequential", "shuffled" })
+	{
+		std::cout << "relink of " << n << " " << order << " nodes: loop " << time(xor_relink_scalar)
+			<< " ns/node, xor_relink (" << kernel << ") " << time(xor_relink) << " ns/node" << std::endl;
+		std::shuffle(addresses.begin() + 1, addresses.end() - 1, std::mt19937(3));
+	}
+
+	auto start = benchmark_clock::now();
+	LinkedList<std::uint64_t> built(n * 4, 1);
+	std::cout << "LinkedList(" << n * 4 << ", value): " << elapsed_ns(start, benchmark_clock::now()) / 1e6 << " ms" << std::endl;
+}
+
+void LinkedListBenchmark::pmr_benchmark()
+{
+#ifdef XOR_LIST_PMR
+	// a request builds a few lists of messages, walks them and drops them
+	const std::size_t requests = 20000;
+	const std::size_t lists = 8;
+	const std::size_t messages = 128;
+
+	auto serve = [&](auto make_list, auto finish, auto end_request) {
+		std::vector<double> latencies;
+		latencies.reserve(requests);
+		std::uint64_t sum = 0;
+		for (std::size_t r = 0; r < requests; ++r)
+		{
+			auto start = benchmark_clock::now();
+			{
+				std::vector<decltype(make_list())> work;
+				work.reserve(lists);
+				for (std::size_t l = 0; l < lists; ++l)
+				{
+					work.push_back(make_list());
+					for (std::size_t m = 0; m < messages; ++m)
+					{
+						work.back().push_back(Msg{ m, { r, l, 0 } });
+					}
+				}
+				for (auto& list : work)
+				{
+					for (const auto& msg : list)
+					{
+						sum += msg.id;
+					}
+					finish(list);
+				}
+			}
+			end_request();
+			latencies.push_back(elapsed_ns(start, benchmark_clock::now()));
+		}
+		return sum != 0 ? latencies : std::vector<double>();
+	};
+
+	auto plain = serve([] { return LinkedList<Msg>(); }, [](LinkedList<Msg>&) {}, [] {});
+	print_percentiles("request, std::allocator", plain);
+
+	std::vector<char> buffer(lists * messages * sizeof(Msg) * 2);
+	std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size());
+	auto on_arena = [&arena] { return pmr::LinkedList<Msg>(&arena); };
+	auto release = [&arena] { arena.release(); };
+
+	auto walked = serve(on_arena, [](pmr::LinkedList<Msg>&) {}, release);
+	print_percentiles("request, pmr monotonic arena, destructors walk the nodes", walked);
+
+	auto discarded = serve(on_arena, [](pmr::LinkedList<Msg>& list) { list.discard(); }, release);
+	print_percentiles("request, pmr monotonic arena, discard()", discarded);
+#endif
+}
+
+void LinkedListBenchmark::parallel_benchmark()
+{
+	// a scoring pass and a filter count over 10M elements
+	const std::size_t n = 10000000;
+	LinkedList<std::uint64_t> list;
+	for (std::size_t i = 0; i < n; ++i)
+	{
+		list.push_back(i);
+	}
+
+	auto score = [](std::uint64_t& x) {
+		// a few rounds of splitmix64 stand in for real per-element work
+		for (int round = 0; round < 4; ++round)
+		{
+			x += 0x9e3779b97f4a7c15ull;
+			x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+			x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+			x ^= x >> 31;
+		}
+	};
+
+	std::cout << "parallel passes over " << n << " elements, " << std::thread::hardware_concurrency() << " hardware threads" << std::endl;
+	for (std::size_t threads : { 1, 2, 4, 8, 16, 32 })
+	{
+		ParallelPolicy policy;
+		policy.threads = threads;
+
+		auto start = benchmark_clock::now();
+		auto splits = list.split_points(threads);
+		auto split_ms = elapsed_ns(start, benchmark_clock::now()) / 1e6;
+
+		start = benchmark_clock::now();
+		list.parallel_for_each(splits, score);
+		auto for_each_ms = elapsed_ns(start, benchmark_clock::now()) / 1e6;
+
+		start = benchmark_clock::now();
+		auto kept = list.parallel_transform_reduce(splits, std::size_t(0),
+			[](std::size_t a, std::size_t b) { return a + b; },
+			[](const std::uint64_t x) { return std::size_t((x & 7) == 0); });
+		auto reduce_ms = elapsed_ns(start, benchmark_clock::now()) / 1e6;
+
+		std::cout << "  " << threads << " threads: split_points " << split_ms << " ms, parallel_for_each "
+			<< for_each_ms << " ms, parallel_transform_reduce " << reduce_ms << " ms (" << kept << " kept)" << std::endl;
+	}
+}
+
+void LinkedListBenchmark::rcu_benchmark()
+{
+	// readers scan a 64 entry config list while one writer replaces an entry every millisecond
+	const std::size_t entries = 64;
+	const auto duration = std::chrono::milliseconds(300);
+
+	auto measure = [&](const std::size_t threads, auto make_read, auto write) {
+		std::atomic<bool> done(false);
+		std::atomic<std::uint64_t> reads(0);
+		std::atomic<std::uint64_t> checksum(0);
+		std::vector<std::thread> readers;
+		for (std::size_t t = 0; t < threads; ++t)
+		{
+			readers.emplace_back([&] {
+				auto read = make_read();
+				std::uint64_t mine = 0;
+				std::uint64_t sum = 0;
+				while (!done.load(std::memory_order_relaxed))
+				{
+					sum += read();
+					++mine;
+				}
+				reads.fetch_add(mine);
+				checksum.fetch_add(sum);
+			});
+		}
+
+		// a reader-preferring shared_mutex can starve the writer, so the clock stops the run
+		std::thread writer([&] {
+			for (int i = 0; !done.load(); ++i)
+			{
+				write(i);
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+		});
+		std::this_thread::sleep_for(duration);
+		done.store(true);
+		for (auto& reader : readers)
+		{
+			reader.join();
+		}
+		writer.join();
+		auto per_second = static_cast<double>(reads.load()) / std::chrono::duration<double>(duration).count();
+		return checksum.load() != 0 ? per_second / 1e6 : 0;
+	};
+
+	for (std::size_t threads : { 1, 2, 4, 8 })
+	{
+		LinkedList<std::uint64_t> locked(entries, 1);
+		std::shared_mutex mutex;
+		auto with_mutex = measure(threads,
+			[&] {
+				return [&] {
+					std::shared_lock<std::shared_mutex> lock(mutex);
+					std::uint64_t sum = 0;
+					for (auto x : locked)
+					{
+						sum += x;
+					}
+					return sum;
+				};
+			},
+			[&](int i) {
+				std::unique_lock<std::shared_mutex> lock(mutex);
+				locked.pop_front();
+				locked.push_back(static_cast<std::uint64_t>(i));
+			});
+
+		RcuXorList<std::uint64_t> rcu;
+		rcu.update([entries](LinkedList<std::uint64_t>& list) { list.assign(entries, 1); });
+		auto with_rcu = measure(threads,
+			[&] {
+				auto reader = std::make_shared<RcuXorList<std::uint64_t>::Reader>(rcu.reader());
+				return [reader] {
+					return reader->read([](const LinkedList<std::uint64_t>& list) {
+						std::uint64_t sum = 0;
+						for (auto x : list)
+						{
+							sum += x;
+						}
+						return sum;
+					});
+				};
+			},
+			[&](int i) {
+				rcu.update([i](LinkedList<std::uint64_t>& list) {
+					list.pop_front();
+					list.push_back(static_cast<std::uint64_t>(i));
+				});
+			});
+
+		std::cout << "config reads, " << threads << " threads: shared_mutex " << with_mutex << " M/s, RcuXorList "
+			<< with_rcu << " M/s" << std::endl;
+	}
+}
+
+void LinkedListBenchmark::huge_page_benchmark()
+{
+	// nodes relinked in random order by sort, so nearly every hop lands on another page
+	const std::size_t nodes = std::size_t(1) << 22;
+	const int passes = 5;
+
+	auto measure = [nodes, passes](auto list) {
+		std::mt19937_64 random(7);
+		for (std::size_t i = 0; i < nodes; ++i)
+		{
+			list.push_back(random());
+		}
+		list.sort();
+
+		std::uint64_t sum = 0;
+		TlbMissCounter misses;
+		misses.start();
+		auto start = benchmark_clock::now();
+		for (int pass = 0; pass < passes; ++pass)
+		{
+			for (auto x : list)
+			{
+				sum += x;
+			}
+		}
+		auto ns = elapsed_ns(start, benchmark_clock::now());
+		auto counted = misses.read();
+		volatile std::uint64_t consumed = sum;
+		(void)consumed;
+
+		std::cout << ns / (passes * nodes) << " ns/hop, dTLB misses/hop ";
+		if (counted < 0)
+		{
+			std::cout << "n/a";
+		}
+		else
+		{
+			std::cout << static_cast<double>(counted) / (passes * nodes);
+		}
+		std::cout << std::endl;
+	};
+
+	std::cout << "shuffled traversal of " << nodes << " nodes, operator new slabs: ";
+	measure(LinkedList<std::uint64_t, PoolAllocator<std::uint64_t>>());
+	std::cout << "shuffled traversal of " << nodes << " nodes, huge page slabs: ";
+	measure(LinkedList<std::uint64_t, PoolAllocator<std::uint64_t, true>>());
+	using HugePool = NodePool<node_pool_size<Node<std::uint64_t>>(), true>;
+	std::cout << "huge page slabs mapped: " << HugePool::mapped_slabs()
+		<< ", advised: " << HugePool::huge_page_slabs() << std::endl;
+}
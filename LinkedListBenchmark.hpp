@@ -0,0 +1,27 @@
+#ifndef _LINKED_LIST_BENCHMARK_HPP_
+#define _LINKED_LIST_BENCHMARK_HPP_
+#include "LinkedList.hpp"
+
+/*
+	Rough timings for LinkedList workloads, printed to stdout
+	Build with optimizations and run as "main bench"
+*/
+
+class LinkedListBenchmark
+{
+public:
+	static void run();
+private:
+	static void queue_churn_benchmark();
+	static void channel_benchmark();
+	static void node_pool_benchmark();
+	static void deferred_clear_benchmark();
+	static void compact_benchmark();
+	static void lru_benchmark();
+	static void relink_benchmark();
+	static void pmr_benchmark();
+	static void parallel_benchmark();
+	static void rcu_benchmark();
+	static void huge_page_benchmark();
+};
+#endif /* _LINKED_LIST_BENCHMARK_HPP_ */
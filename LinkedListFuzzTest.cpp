@@ -0,0 +1,475 @@
+#include "LinkedListFuzzTest.hpp"
+#include "LinkedList.hpp"
+#include "SmallXorList.hpp"
+#include <cassert>
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <iterator>
+#include <list>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+	// assert() may be compiled out, a mismatch must always stop the run
+	void check(const bool condition, const char* what)
+	{
+		if (!condition)
+		{
+			std::cerr << "LinkedList differs from std::list after " << what << std::endl;
+			std::abort();
+		}
+	}
+
+	class Input
+	{
+	public:
+		Input(const std::uint8_t* _data, std::size_t _size, std::size_t _max_walk)
+			: data(_data)
+			, size(_size)
+			, offset(0)
+			, max_walk(_max_walk)
+		{}
+
+		bool done() const { return offset >= size; }
+		std::uint8_t byte() { return done() ? 0 : data[offset++]; }
+
+		// index in [0, n], at most max_walk away from either end
+		std::size_t index(std::size_t n)
+		{
+			auto i = (static_cast<std::size_t>(byte()) << 8 | byte()) % (n + 1);
+			if (n <= 2 * max_walk || i <= max_walk || n - i <= max_walk)
+			{
+				return i;
+			}
+			return (i % 2 == 0) ? i % max_walk : n - i % max_walk;
+		}
+		int value() { return byte() % 16; }
+
+	private:
+		const std::uint8_t* data;
+		std::size_t size;
+		std::size_t offset;
+		std::size_t max_walk;
+	};
+
+	template <class List>
+	typename List::iterator at(List& list, std::size_t i)
+	{
+		if (i <= list.size() / 2)
+		{
+			auto it = list.begin();
+			std::advance(it, i);
+			return it;
+		}
+
+		auto it = list.end();
+		for (auto n = list.size(); n > i; --n)
+		{
+			--it;
+		}
+		return it;
+	}
+
+	template <class List>
+	void same(const List& list, const std::list<int>& model, const char* what)
+	{
+		check(list.size() == model.size(), what);
+		check(list.empty() == model.empty(), what);
+
+		auto j = model.begin();
+		for (auto i = list.begin(); i != list.end(); ++i, ++j)
+		{
+			check(j != model.end() && *i == *j, what);
+		}
+		check(j == model.end(), what);
+
+		// walking back from end() exercises the other direction of every link
+		auto r = model.rbegin();
+		auto i = list.end();
+		for (std::size_t n = 0; n < list.size(); ++n, ++r)
+		{
+			--i;
+			check(*i == *r, what);
+		}
+
+		if (!model.empty())
+		{
+			check(list.front() == model.front() && list.back() == model.back(), what);
+		}
+	}
+
+	struct Pair
+	{
+		LinkedList<int> list;
+		SmallXorList<int, 4> other;
+		std::list<int> list_model;
+		std::list<int> other_model;
+	};
+
+	enum Operation
+	{
+		PushBack, PushFront, PopBack, PopFront, Insert, InsertRange, Erase, EraseRange,
+		SpliceAll, SpliceOne, SpliceRange, Sort, Merge, Unique, Reverse, Resize,
+		Assign, Clear, Swap, Copy, CursorEdit, NodeCache, OtherPush, PopFrontN, PopBackN, Drain, Compact, SplitAt, StablePartition, DedupUnordered, OperationCount
+	};
+
+	const char* names[] = {
+		"push_back", "push_front", "pop_back", "pop_front", "insert", "insert range", "erase", "erase range",
+		"splice all", "splice one", "splice range", "sort", "merge", "unique", "reverse", "resize",
+		"assign", "clear", "swap", "copy", "cursor edit", "node cache", "push_back on the other list",
+		"pop_front_n", "pop_back_n", "drain_into", "compact", "split_at", "stable_partition", "dedup_unordered"
+	};
+
+	void apply(Pair& p, Input& in, const std::size_t max_size)
+	{
+		auto& list = p.list;
+		auto& model = p.list_model;
+		const auto operation = static_cast<Operation>(in.byte() % OperationCount);
+		const auto n = model.size();
+
+		switch (operation)
+		{
+		case PushBack:
+		{
+			if (n < max_size) { auto v = in.value(); list.push_back(v); model.push_back(v); }
+			break;
+		}
+		case PushFront:
+		{
+			if (n < max_size) { auto v = in.value(); list.push_front(v); model.push_front(v); }
+			break;
+		}
+		case PopBack:
+		{
+			if (n > 0) { list.pop_back(); model.pop_back(); }
+			break;
+		}
+		case PopFront:
+		{
+			if (n > 0) { list.pop_front(); model.pop_front(); }
+			break;
+		}
+		case Insert:
+		{
+			auto i = in.index(n);
+			auto v = in.value();
+			auto it = list.insert(at(list, i), v);
+			model.insert(at(model, i), v);
+			check(*it == v, names[operation]);
+			break;
+		}
+		case InsertRange:
+		{
+			// LinkedList inserts every element before the previous one, so the range ends up reversed
+			auto i = in.index(n);
+			const int values[] = { in.value(), in.value(), in.value() };
+			list.insert(at(list, i), values, values + 3);
+			model.insert(at(model, i), std::reverse_iterator<const int*>(values + 3), std::reverse_iterator<const int*>(values));
+			break;
+		}
+		case Erase:
+		{
+			if (n == 0) { break; }
+			auto i = in.index(n - 1);
+			auto it = list.erase(at(list, i));
+			auto jt = model.erase(at(model, i));
+			check((it == list.end()) == (jt == model.end()), names[operation]);
+			if (jt != model.end())
+			{
+				check(*it == *jt, names[operation]);
+			}
+			break;
+		}
+		case EraseRange:
+		{
+			auto i = in.index(n);
+			auto j = i + in.index(n - i);
+			list.erase(at(list, i), at(list, j));
+			model.erase(at(model, i), at(model, j));
+			break;
+		}
+		case SpliceAll:
+		{
+			if (n + p.other_model.size() > max_size) { p.other.clear(); p.other_model.clear(); break; }
+			auto i = in.index(n);
+			list.splice(at(list, i), p.other);
+			model.splice(at(model, i), p.other_model);
+			break;
+		}
+		case SpliceOne:
+		{
+			if (p.other_model.empty()) { break; }
+			auto i = in.index(n);
+			auto j = in.index(p.other_model.size() - 1);
+			list.splice(at(list, i), p.other, at(p.other, j));
+			model.splice(at(model, i), p.other_model, at(p.other_model, j));
+			break;
+		}
+		case SpliceRange:
+		{
+			auto m = p.other_model.size();
+			auto i = in.index(n);
+			auto first = in.index(m);
+			auto last = first + in.index(m - first);
+			list.splice(at(list, i), p.other, at(p.other, first), at(p.other, last));
+			model.splice(at(model, i), p.other_model, at(p.other_model, first), at(p.other_model, last));
+			break;
+		}
+		case Sort:
+		{
+			list.sort();
+			model.sort();
+			break;
+		}
+		case Merge:
+		{
+			list.sort();
+			model.sort();
+			p.other.sort();
+			p.other_model.sort();
+			list.merge(p.other);
+			model.merge(p.other_model);
+			break;
+		}
+		case Unique:
+		{
+			list.unique();
+			model.unique();
+			break;
+		}
+		case Reverse:
+		{
+			list.reverse();
+			model.reverse();
+			break;
+		}
+		case Resize:
+		{
+			auto size = in.index(max_size);
+			auto v = in.value();
+			list.resize(size, v);
+			model.resize(size, v);
+			break;
+		}
+		case Assign:
+		{
+			auto count = in.index(8);
+			auto v = in.value();
+			list.assign(count, v);
+			model.assign(count, v);
+			break;
+		}
+		case Clear:
+		{
+			list.clear();
+			model.clear();
+			break;
+		}
+		case Swap:
+		{
+			list.swap(p.other);
+			model.swap(p.other_model);
+			break;
+		}
+		case Copy:
+		{
+			LinkedList<int> copy(list);
+			same(copy, model, names[operation]);
+			copy.push_back(in.value());
+			LinkedList<int> assigned;
+			assigned = copy;
+			assigned.pop_back();
+			same(assigned, model, names[operation]);
+			break;
+		}
+		case CursorEdit:
+		{
+			auto i = in.index(n);
+			auto v = in.value();
+			auto cursor = list.make_cursor(at(list, i));
+			auto it = at(model, i);
+			switch (in.byte() % 3)
+			{
+			case 0:
+				cursor.insert_before(v);
+				model.insert(it, v);
+				break;
+			case 1:
+				if (i < n) { cursor.insert_after(v); model.insert(std::next(it), v); }
+				break;
+			default:
+				if (i < n) { cursor.erase(); it = model.erase(it); }
+				break;
+			}
+			check(cursor.at_end() == (it == model.end()), names[operation]);
+			if (!cursor.at_end())
+			{
+				check(*cursor == *it, names[operation]);
+			}
+			break;
+		}
+		case NodeCache:
+		{
+			list.set_node_cache_capacity(in.index(8));
+			break;
+		}
+		case OtherPush:
+		{
+			if (p.other_model.size() < max_size) { auto v = in.value(); p.other.push_back(v); p.other_model.push_back(v); }
+			break;
+		}
+		case PopFrontN:
+		case PopBackN:
+		{
+			// either list can be the source, the plain one and the one with inline nodes take different paths
+			const bool from_other = in.byte() % 2 == 0;
+			LinkedList<int>& source = from_other ? static_cast<LinkedList<int>&>(p.other) : list;
+			auto& source_model = from_other ? p.other_model : model;
+			LinkedList<int>& target = from_other ? list : static_cast<LinkedList<int>&>(p.other);
+			auto& target_model = from_other ? model : p.other_model;
+
+			auto m = source_model.size();
+			auto count = std::min(in.index(m), max_size - std::min(max_size, target_model.size()));
+			auto taken = (operation == PopFrontN) ? source.pop_front_n(count) : source.pop_back_n(count);
+			std::list<int> taken_model;
+			auto first = (operation == PopFrontN) ? source_model.begin() : at(source_model, m - count);
+			auto last = (operation == PopFrontN) ? at(source_model, count) : source_model.end();
+			taken_model.splice(taken_model.end(), source_model, first, last);
+			same(taken, taken_model, names[operation]);
+
+			// the detached list is a normal list
+			target.splice(target.end(), taken);
+			target_model.splice(target_model.end(), taken_model);
+			break;
+		}
+		case Drain:
+		{
+			std::vector<int> drained;
+			list.drain_into(std::back_inserter(drained));
+			check(std::equal(drained.begin(), drained.end(), model.begin(), model.end()), names[operation]);
+			model.clear();
+			break;
+		}
+		case Compact:
+		{
+			// the other list mixes inline nodes into the block
+			if (in.byte() % 2 == 0) { list.compact(); } else { p.other.compact(); }
+			break;
+		}
+		case SplitAt:
+		{
+			const bool from_other = in.byte() % 2 == 0;
+			LinkedList<int>& source = from_other ? static_cast<LinkedList<int>&>(p.other) : list;
+			auto& source_model = from_other ? p.other_model : model;
+
+			auto m = source_model.size();
+			auto k = in.index(m);
+			auto position = at(source, k);
+			auto suffix = (in.byte() % 2 == 0) ? source.split_at(position) : source.split_at(position, m - k);
+			std::list<int> suffix_model;
+			suffix_model.splice(suffix_model.end(), source_model, at(source_model, k), source_model.end());
+			same(suffix, suffix_model, names[operation]);
+			same(source, source_model, names[operation]);
+
+			// put it back in front, which rotates the list
+			source.splice(source.begin(), suffix);
+			source_model.splice(source_model.begin(), suffix_model);
+			break;
+		}
+		case StablePartition:
+		{
+			const int divisor = 2 + in.byte() % 3;
+			auto pred = [divisor](const int x) { return x % divisor == 0; };
+			auto second = list.stable_partition(pred);
+			auto second_model = std::stable_partition(model.begin(), model.end(), pred);
+			check((second == list.end()) == (second_model == model.end()), names[operation]);
+			check(second == list.end() || *second == *second_model, names[operation]);
+			break;
+		}
+		case DedupUnordered:
+		{
+			// values equal modulo divisor are duplicates
+			const int divisor = 1 + in.byte() % 64;
+			auto key = [divisor](const int x) { return (x % divisor + divisor) % divisor; };
+			auto removed = list.dedup_unordered([key](const int x) { return std::hash<int>()(key(x)); },
+				[key](const int x, const int y) { return key(x) == key(y); });
+
+			std::unordered_set<int> seen;
+			std::size_t removed_model = 0;
+			for (auto it = model.begin(); it != model.end();)
+			{
+				if (seen.insert(key(*it)).second)
+				{
+					++it;
+				}
+				else
+				{
+					it = model.erase(it);
+					++removed_model;
+				}
+			}
+			check(removed == removed_model, names[operation]);
+			break;
+		}
+		default:
+			break;
+		}
+	}
+}
+
+void LinkedListFuzzTest::run_input(const std::uint8_t* data, std::size_t size, std::size_t max_size, std::size_t check_every)
+{
+	Pair p;
+	const std::size_t max_walk = max_size <= 1024 ? max_size : 64;
+	Input in(data, size, max_walk);
+	for (std::size_t step = 1; !in.done(); ++step)
+	{
+		apply(p, in, max_size);
+
+		// short lists are cheap to compare, so they are compared after every step
+		const bool short_lists = p.list.size() <= max_walk && p.other.size() <= max_walk;
+		if (short_lists || step % check_every == 0 || in.done())
+		{
+			same(p.list, p.list_model, "a step");
+			same(p.other, p.other_model, "a step");
+		}
+	}
+}
+
+void LinkedListFuzzTest::run(std::size_t operations, std::size_t max_size)
+{
+	std::mt19937 random(20160427);
+	std::vector<std::uint8_t> bytes;
+
+	// many short histories find edge cases near empty lists, a few long ones reach max_size
+	const std::size_t history = 2000;
+	for (std::size_t done = 0; done < operations; done += history)
+	{
+		bytes.resize(history * 4);
+		for (auto& b : bytes)
+		{
+			b = static_cast<std::uint8_t>(random());
+		}
+		run_input(bytes.data(), bytes.size(), max_size);
+	}
+}
+
+void LinkedListFuzzTest::stress()
+{
+	// millions of operations on short lists, each one checked
+	run(4000000, 64);
+
+	// long lists, compared every few steps and after every step while they are short
+	std::mt19937 random(4201);
+	std::vector<std::uint8_t> bytes(8000000);
+	for (auto& b : bytes)
+	{
+		b = static_cast<std::uint8_t>(random());
+	}
+	run_input(bytes.data(), bytes.size(), 20000, 16);
+	std::cout << "Stress test passed" << std::endl;
+}
@@ -0,0 +1,26 @@
+#ifndef _LINKED_LIST_FUZZ_TEST_HPP_
+#define _LINKED_LIST_FUZZ_TEST_HPP_
+#include <cstddef>
+#include <cstdint>
+
+/*
+	Differential test: the same random operations are applied to LinkedList and std::list
+	and both are compared after every step
+	Operations are decoded from a byte string, so the same driver serves
+	the random runs below and the libFuzzer entry point in LinkedListFuzzer.cpp
+*/
+
+class LinkedListFuzzTest
+{
+public:
+	// random byte strings from a fixed seed, lists stay around max_size elements
+	static void run(std::size_t operations = 200000, std::size_t max_size = 64);
+
+	// millions of operations checked after every step, then large lists checked every few steps
+	static void stress();
+
+	// applies the operations encoded in data, aborts on the first mismatch
+	// lists no longer than the walk limit are compared after every step whatever check_every is
+	static void run_input(const std::uint8_t* data, std::size_t size, std::size_t max_size = 64, std::size_t check_every = 1);
+};
+#endif /* _LINKED_LIST_FUZZ_TEST_HPP_ */
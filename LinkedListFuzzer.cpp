@@ -0,0 +1,12 @@
+/*
+	libFuzzer entry point, build without main.cpp:
+	clang++ -std=c++17 -g -fsanitize=fuzzer,address,undefined LinkedListFuzzer.cpp LinkedListFuzzTest.cpp
+*/
+
+#include "LinkedListFuzzTest.hpp"
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)
+{
+	LinkedListFuzzTest::run_input(data, size);
+	return 0;
+}
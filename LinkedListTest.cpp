@@ -1,8 +1,27 @@
 #include "LinkedListTest.hpp"
+#include "NodePool.hpp"
+#include "NodeReclaimer.hpp"
+#include "RcuXorList.hpp"
+#include "SmallXorList.hpp"
+#include "SortedXorList.hpp"
+#include "StaticXorList.hpp"
+#include "XorChannel.hpp"
+#include "XorLinkedHashMap.hpp"
+#include "XorRelink.hpp"
 #include <cassert>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <iterator>
 #include <iostream>
+#include <list>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace
 {
@@ -29,6 +48,69 @@ namespace
 
 		return true;
 	}
+
+	// no default constructor, counts its copies
+	struct Counted
+	{
+		explicit Counted(int _value) : value(_value) {}
+		Counted(const Counted& other) : value(other.value) { ++copies; }
+		Counted(Counted&& other) noexcept : value(other.value) {}
+		Counted& operator=(const Counted&) = delete;
+		Counted& operator=(Counted&&) = delete;
+
+		int value;
+		static int copies;
+	};
+
+	int Counted::copies = 0;
+
+	constexpr StaticXorList<int, 8> make_table()
+	{
+		StaticXorList<int, 8> table = { 3, 1, 3 };
+		StaticXorList<int, 4> more = { 2, 2 };
+		table.sort();
+		table.merge(more);
+		table.unique();
+		table.push_front(0);
+		table.pop_front();
+		return table;
+	}
+
+	template <class List>
+	constexpr int weighted_sum(const List& list)
+	{
+		int sum = 0;
+		int weight = 1;
+		for (auto x : list)
+		{
+			sum += weight * x;
+			++weight;
+		}
+		return sum;
+	}
+
+#ifdef XOR_CHANNEL_COROUTINES
+	// fire-and-forget coroutine, enough to drive XorChannel::async_pop
+	struct Detached
+	{
+		struct promise_type
+		{
+			Detached get_return_object() { return Detached(); }
+			std::suspend_never initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+			void return_void() {}
+			void unhandled_exception() { std::terminate(); }
+		};
+	};
+
+	Detached consume(XorChannel<int>& channel, LinkedList<int>& received)
+	{
+		while (auto value = co_await channel.async_pop())
+		{
+			received.push_back(*value);
+		}
+	}
+#endif
 }
 
 const LinkedList<int> LinkedListTest::must = { 1, 2, 3 };
@@ -49,6 +131,25 @@ void LinkedListTest::run()
 	resize_test();
 	unique_test();
 	iterators_test();
+	node_cache_test();
+	small_list_test();
+	cursor_test();
+	channel_test();
+	static_list_test();
+	sorted_list_test();
+	node_pool_test();
+	bulk_pop_test();
+	move_only_test();
+	deferred_clear_test();
+	compact_test();
+	linked_hash_map_test();
+	relink_test();
+	pmr_test();
+	parallel_test();
+	rcu_test();
+	split_partition_test();
+	huge_page_pool_test();
+	dedup_unordered_test();
 	std::cout << "All test passed" << std::endl;
 }
 
@@ -103,6 +204,22 @@ void LinkedListTest::sort_test()
 		list.sort();
 		assert(equal(list, must));
 	} while (std::next_permutation(values, values + 3));	
+
+	// long sorted runs used to recurse once per element
+	LinkedList<int> big;
+	for (int i = 100000; i > 0; --i)
+	{
+		big.push_back(i / 2);
+	}
+	big.sort();
+	assert(big.size() == 100000);
+	assert(std::is_sorted(big.begin(), big.end()));
+
+	// equal keys keep their order
+	LinkedList<std::pair<int, int>> pairs = { { 2, 0 }, { 1, 1 }, { 2, 2 }, { 1, 3 } };
+	pairs.sort([](const std::pair<int, int>& a, const std::pair<int, int>& b) { return a.first < b.first; });
+	const LinkedList<std::pair<int, int>> stable = { { 1, 1 }, { 1, 3 }, { 2, 0 }, { 2, 2 } };
+	assert(equal(pairs, stable));
 }
 
 void LinkedListTest::splice_test()
@@ -113,6 +230,29 @@ void LinkedListTest::splice_test()
 
 	l1.splice(l1.begin(), l2);
 	assert(equal(l1, must));
+
+	// elements that can't be moved are relinked, never copied out
+	LinkedList< std::atomic<int> > a1;
+	LinkedList< std::atomic<int> > a2;
+	for (int i = 1; i <= 4; ++i)
+	{
+		a1.emplace_back(2 * i - 1);
+		a2.emplace_back(2 * i);
+	}
+	const auto* const two = &a2.front();
+	a1.splice(a1.end(), a2, a2.begin());
+	a1.splice(a1.begin(), a2, a2.begin(), std::next(a2.begin()));
+	assert(&a1.back() == two && a1.front() == 4 && a2.size() == 2);
+	a1.sort([](const std::atomic<int>& x, const std::atomic<int>& y) { return x < y; });
+	a1.merge(a2, [](const std::atomic<int>& x, const std::atomic<int>& y) { return x < y; });
+	auto rest = a1.split_at(std::next(a1.begin(), 4));
+	assert(a2.empty() && a1.size() == 4 && rest.size() == 4);
+	int expected = 1;
+	for (const auto& x : a1)
+	{
+		assert(x == expected++);
+	}
+	assert(rest.front() == 5 && rest.back() == 8);
 }
 
 void LinkedListTest::merge_test()
@@ -147,6 +287,17 @@ void LinkedListTest::reverse_test()
 	list.assign({ 4, 3, 2, 1 });
 	list.reverse();
 	assert(equal(list, must_even));
+
+	// iterators taken after reverse() walk the new order both ways
+	auto second = std::next(list.begin());
+	assert(*second == 2 && *std::next(second) == 3 && *std::prev(second) == 1);
+	auto last = std::prev(list.end());
+	assert(*last == 4 && *std::prev(last) == 3);
+	list.erase(second);
+	list.reverse();
+	const LinkedList<int> reversed = { 4, 3, 1 };
+	assert(equal(list, reversed));
+	assert(*std::next(list.begin()) == 3 && *std::prev(list.end()) == 1);
 }
 
 void LinkedListTest::erase_test()
@@ -196,3 +347,909 @@ void LinkedListTest::iterators_test()
 
 	assert(equal(list, must));
 }
+
+void LinkedListTest::node_cache_test()
+{
+	// the cache, inline storage, reclaimer and compact() block live outside the list object
+	static_assert(sizeof(LinkedList<int>) <= 6 * sizeof(void*), "a plain list stays small");
+
+	LinkedList<int> list = { 1, 2, 3 };
+	assert(list.node_cache_capacity() == 0);
+	list.pop_back();
+	assert(list.node_cache_size() == 0);
+
+	list.push_back(3);
+	list.set_node_cache_capacity(2);
+	list.pop_front();
+	list.pop_back();
+	assert(list.node_cache_size() == 2);
+
+	// cached nodes are reused before the allocator is asked
+	list.push_front(1);
+	list.push_back(3);
+	assert(list.node_cache_size() == 0);
+	assert(equal(list, must));
+
+	list.set_node_cache_capacity(1);
+	list.clear();
+	assert(list.node_cache_size() == 1);
+
+	list.shrink_to_fit();
+	assert(list.node_cache_size() == 0);
+	assert(list.node_cache_capacity() == 1);
+
+	// the capacity stays with the list object through copies and assignments
+	LinkedList<int> cached = { 1, 2, 3 };
+	cached.set_node_cache_capacity(4);
+	const LinkedList<int> copied(cached);
+	assert(copied.node_cache_capacity() == 0);
+
+	LinkedList<int> uncached;
+	uncached = cached;
+	assert(uncached.node_cache_capacity() == 0 && equal(uncached, must));
+	cached = list;
+	assert(cached.node_cache_capacity() == 4 && equal(cached, list));
+
+	SmallXorList<int, 2> small;
+	static_cast<LinkedList<int>&>(small) = cached;
+	assert(small.node_cache_capacity() == 0);
+	small.set_node_cache_capacity(3);
+	static_cast<LinkedList<int>&>(small) = uncached;
+	assert(small.node_cache_capacity() == 3 && equal(small, must));
+	const SmallXorList<int, 2> small_copy(small);
+	assert(small_copy.node_cache_capacity() == 0);
+	small = small_copy;
+	assert(small.node_cache_capacity() == 3);
+}
+
+void LinkedListTest::small_list_test()
+{
+	SmallXorList<int, 2> small = { 1, 2 };
+	assert(small.node_cache_size() == 0);
+
+	// the third node spills to the allocator
+	small.push_back(3);
+	assert(equal(small, must));
+
+	// inline nodes are copied out, heap nodes are relinked
+	LinkedList<int> list;
+	list.splice(list.end(), small);
+	assert(small.empty());
+	assert(equal(list, must));
+
+	SmallXorList<int, 2> moved = { 3 };
+	moved.push_front(2);
+	moved.push_front(1);
+	SmallXorList<int, 2> other(std::move(moved));
+	assert(moved.empty());
+	assert(equal(other, must));
+
+	LinkedList<int> swapped;
+	swapped.swap(other);
+	assert(other.empty());
+	assert(equal(swapped, must));
+}
+
+void LinkedListTest::cursor_test()
+{
+	const LinkedList<int> must = { 1, 2, 3, 4, 5, 6 };
+
+	LinkedList<int> list = { 0, 2, 5 };
+	auto cursor = list.make_cursor(list.begin());
+	cursor.erase();
+	cursor.insert_before(1);
+	assert(*cursor == 2);
+
+	++cursor;
+	cursor.insert_before(3);
+	cursor.insert_after(6);
+	LinkedList<int> four = { 4 };
+	cursor.splice_here(four);
+	assert(*cursor == 5);
+
+	--cursor;
+	assert(*cursor == 4);
+	assert(equal(list, must));
+
+	// the cursor position is a valid iterator
+	auto i = cursor.position();
+	--i;
+	assert(*i == 3);
+
+	auto tail = list.make_cursor(list.end());
+	tail.insert_before(7);
+	assert(tail.at_end());
+	assert(list.back() == 7);
+}
+
+void LinkedListTest::channel_test()
+{
+	XorChannel<int> channel(2);
+	assert(channel.try_push(1));
+	assert(channel.try_push(2));
+	assert(!channel.try_push(3));
+
+	int value = 0;
+	assert(channel.try_pop(value) && value == 1);
+	assert(channel.push(3));
+
+	auto batch = channel.pop_n(10);
+	const LinkedList<int> rest = { 2, 3 };
+	assert(equal(batch, rest));
+	assert(!channel.try_pop(value));
+
+	// the consumer drains everything pushed before close
+	XorChannel<int> pipe(4);
+	LinkedList<int> received;
+	std::thread consumer([&pipe, &received] {
+		int x = 0;
+		while (pipe.pop(x))
+		{
+			received.push_back(x);
+		}
+	});
+	for (int i = 1; i <= 3; ++i)
+	{
+		pipe.push(i);
+	}
+	pipe.close();
+	consumer.join();
+	assert(equal(received, must));
+	assert(!pipe.push(4));
+
+#ifdef XOR_CHANNEL_COROUTINES
+	XorChannel<int> awaited;
+	LinkedList<int> resumed;
+	consume(awaited, resumed);
+	for (int i = 1; i <= 3; ++i)
+	{
+		awaited.push(i);
+	}
+	awaited.close();
+	assert(equal(resumed, must));
+#endif
+}
+
+void LinkedListTest::static_list_test()
+{
+	constexpr auto table = make_table();
+	static_assert(table.size() == 3, "sort, merge and unique run at compile time");
+	static_assert(weighted_sum(table) == 1 * 1 + 2 * 2 + 3 * 3, "iteration runs at compile time");
+
+	auto i = table.end();
+	--i;
+	assert(*i == 3);
+	--i;
+	assert(*i == 2);
+	assert(table.front() == 1);
+
+	StaticXorList<int, 2> full;
+	full.push_back(1);
+	full.push_back(2);
+	bool thrown = false;
+	try
+	{
+		full.push_back(3);
+	}
+	catch (const std::length_error&)
+	{
+		thrown = true;
+	}
+	assert(thrown && full.size() == 2);
+
+	StaticXorList<int, 3> more;
+	more.push_back(0);
+	more.push_back(3);
+	thrown = false;
+	try
+	{
+		full.merge(more);
+	}
+	catch (const std::length_error&)
+	{
+		thrown = true;
+	}
+	assert(thrown && full.size() == 2 && more.size() == 2);
+	assert(full.front() == 1 && full.back() == 2 && more.front() == 0 && more.back() == 3);
+}
+
+void LinkedListTest::sorted_list_test()
+{
+	SortedXorList<int> sorted;
+	for (int i = 0; i < 1000; ++i)
+	{
+		sorted.insert_sorted((i * 7919) % 500);
+	}
+	assert(sorted.size() == 1000);
+	assert(std::is_sorted(sorted.begin(), sorted.end()));
+
+	auto first = sorted.lower_bound(42);
+	auto last = sorted.upper_bound(42);
+	assert(*first == 42);
+	assert(std::distance(first, last) == 2);
+	--first;
+	assert(*first == 41);
+
+	assert(sorted.erase(42) == 2);
+	assert(sorted.erase(42) == 0);
+	assert(*sorted.lower_bound(42) == 43);
+
+	for (int i = 0; i < 500; i += 2)
+	{
+		assert(sorted.erase(i) == (i == 42 ? 0u : 2u));
+	}
+	assert(sorted.size() == 500);
+	assert(std::is_sorted(sorted.begin(), sorted.end()));
+	assert(*sorted.lower_bound(0) == 1);
+	assert(sorted.upper_bound(499) == sorted.end());
+}
+
+void LinkedListTest::node_pool_test()
+{
+	using PooledList = LinkedList<int, PoolAllocator<int>>;
+
+	PooledList l1 = { 1, 3 };
+	PooledList l2 = { 2 };
+	l1.merge(l2);
+	assert(l2.empty());
+	assert(std::equal(l1.begin(), l1.end(), must.begin()));
+
+	// nodes allocated here are freed on another thread and come back through the depot
+	std::thread other([&l1] {
+		PooledList local;
+		local.splice(local.end(), l1);
+		for (int i = 0; i < 1000; ++i)
+		{
+			local.push_back(i);
+		}
+	});
+	other.join();
+	assert(l1.empty());
+
+	const auto reserved = NodePool<node_pool_size<Node<int>>()>::reserved_blocks();
+	PooledList reused;
+	for (int i = 0; i < 1000; ++i)
+	{
+		reused.push_back(i);
+	}
+	assert(NodePool<node_pool_size<Node<int>>()>::reserved_blocks() == reserved);
+}
+
+void LinkedListTest::bulk_pop_test()
+{
+	const LinkedList<int> last = { 4, 5 };
+
+	LinkedList<int> list = { 1, 2, 3, 4, 5 };
+	auto front = list.pop_front_n(3);
+	assert(equal(front, must));
+	assert(equal(list, last));
+
+	list.splice(list.begin(), front);
+	auto back = list.pop_back_n(2);
+	assert(equal(back, last));
+	assert(equal(list, must));
+
+	auto all = list.pop_front_n(10);
+	assert(list.empty());
+	assert(equal(all, must));
+
+	int out[3] = {};
+	assert(all.drain_into(out) == out + 3);
+	assert(all.empty());
+	assert(out[0] == 1 && out[1] == 2 && out[2] == 3);
+
+	// an output that throws keeps the undrained elements in a valid list
+	struct ThrowingOutput
+	{
+		int* taken;
+		int limit;
+		ThrowingOutput& operator*() { return *this; }
+		ThrowingOutput& operator++() { return *this; }
+		ThrowingOutput& operator=(const int)
+		{
+			if (*taken == limit)
+			{
+				throw std::runtime_error("full");
+			}
+			++*taken;
+			return *this;
+		}
+	};
+	int taken = 0;
+	LinkedList<int> drained = { 1, 2, 3 };
+	try
+	{
+		drained.drain_into(ThrowingOutput{ &taken, 1 });
+	}
+	catch (const std::runtime_error&)
+	{
+	}
+	assert(taken == 1);
+	assert(drained.size() == 2 && drained.front() == 2 && drained.back() == 3);
+	drained.push_front(1);
+	assert(equal(drained, must));
+
+	// several batches freed before the throw
+	LinkedList<int> many;
+	for (int i = 0; i < 200; ++i)
+	{
+		many.push_back(i);
+	}
+	taken = 0;
+	try
+	{
+		many.drain_into(ThrowingOutput{ &taken, 150 });
+	}
+	catch (const std::runtime_error&)
+	{
+	}
+	assert(many.size() == 50 && many.front() == 150 && many.back() == 199);
+	assert(*std::prev(many.end()) == 199 && *std::next(many.begin()) == 151);
+
+	std::vector<int> rest;
+	many.drain_into(std::back_inserter(rest));
+	assert(many.empty() && rest.size() == 50 && rest.front() == 150 && rest.back() == 199);
+}
+
+void LinkedListTest::move_only_test()
+{
+	LinkedList<std::unique_ptr<int>> owners;
+	owners.push_back(std::unique_ptr<int>(new int(3)));
+	owners.emplace_front(new int(1));
+	auto second = owners.begin();
+	++second;
+	owners.insert(second, std::unique_ptr<int>(new int(2)));
+	owners.resize(4);
+	assert(*owners.front() == 1 && owners.back() == nullptr);
+	owners.pop_back();
+
+	LinkedList<std::unique_ptr<int>> moved;
+	moved.splice(moved.end(), owners);
+	moved.reverse();
+	moved.sort([](const std::unique_ptr<int>& a, const std::unique_ptr<int>& b) { return *a < *b; });
+	int expected = 1;
+	for (auto& p : moved)
+	{
+		assert(*p == expected++);
+	}
+
+	LinkedList<Counted> counted;
+	counted.emplace_back(1);
+	Counted three(3);
+	counted.insert(counted.end(), 2, three);
+	assert(Counted::copies == 2);
+
+	Counted source[] = { Counted(4), Counted(5) };
+	counted.insert(counted.end(), std::make_move_iterator(source), std::make_move_iterator(source + 2));
+	assert(Counted::copies == 2);
+	assert(counted.size() == 5 && counted.back().value == 4);
+}
+
+void LinkedListTest::deferred_clear_test()
+{
+	NodeReclaimer reclaimer;
+	{
+		LinkedList<int> list = { 1, 2, 3, 4, 5 };
+		list.set_reclaimer(&reclaimer);
+		list.clear();
+		assert(list.empty());
+		assert(reclaimer.pending() == 5);
+
+		list.assign({ 1, 2, 3 });
+		assert(equal(list, must));
+	}
+	// the destructor retired three more nodes
+	assert(reclaimer.pending() == 8);
+
+	assert(reclaimer.reclaim(6) == 6);
+	assert(reclaimer.pending() == 2);
+	assert(reclaimer.reclaim(10) == 2);
+	assert(reclaimer.pending() == 0);
+
+	reclaimer.start();
+	{
+		LinkedList<int> big(10000);
+		big.set_reclaimer(&reclaimer);
+	}
+	reclaimer.stop();
+	reclaimer.reclaim(10000);
+	assert(reclaimer.pending() == 0);
+}
+
+void LinkedListTest::compact_test()
+{
+	LinkedList<int> list;
+	for (int i = 0; i < 100; ++i)
+	{
+		list.push_front(i);
+		list.push_back(i);
+	}
+	list.sort();
+	const LinkedList<int> sorted(list);
+
+	list.compact();
+	assert(equal(list, sorted));
+	assert(list.average_link_distance() == 1.0);
+
+	// freed block nodes are reused before the allocator is asked again
+	list.pop_front();
+	list.push_back(200);
+	assert(list.back() == 200 && list.size() == 200);
+
+	// block nodes can't leave the list, so splicing copies them
+	LinkedList<int> other;
+	other.splice(other.end(), list, list.begin());
+	other.splice(other.end(), list);
+	assert(list.empty() && other.size() == 200);
+	assert(other.front() == 0 && other.back() == 200);
+
+	LinkedList<int> moved(std::move(other));
+	moved.compact();
+	moved.compact();
+	assert(moved.size() == 200 && moved.front() == 0);
+	moved.clear();
+	moved.compact();
+	assert(moved.average_link_distance() == 0);
+
+	// a block down to a quarter of its nodes in use is given up,
+	// the survivors move to nodes of their own that splice relinks again
+	LinkedList<int> sparse;
+	for (int i = 0; i < 100; ++i)
+	{
+		sparse.push_back(i);
+	}
+	sparse.compact();
+	auto after = sparse.erase(std::next(sparse.begin(), 10), std::next(sparse.begin(), 40));
+	assert(*after == 40 && sparse.size() == 70);
+	auto cursor = sparse.make_cursor(after);
+	for (int i = 0; i < 45; ++i)
+	{
+		cursor.erase();
+	}
+	assert(*cursor.position() == 85 && sparse.size() == 25);
+	auto at = sparse.erase(cursor.position());
+	assert(*at == 86 && sparse.size() == 24);
+	assert(*std::prev(at) == 9 && *std::next(at) == 87);
+
+	const int* const first = &sparse.front();
+	LinkedList<int> taker;
+	taker.splice(taker.end(), sparse);
+	assert(&taker.front() == first && taker.size() == 24 && taker.back() == 99);
+}
+
+void LinkedListTest::linked_hash_map_test()
+{
+	XorLinkedHashMap<int, std::string> map;
+	assert(map.put(1, "one") && map.put(2, "two") && map.put(3, "three"));
+	assert(!map.put(1, "uno"));
+	assert(map.front_key() == 1 && map.back_key() == 2);
+
+	assert(*map.get(2) == "two" && map.front_key() == 2);
+	assert(map.get(4) == nullptr && !map.touch(4));
+	assert(*map.find(3) == "three" && map.front_key() == 2);
+
+	std::string evicted;
+	assert(map.evict_back([&evicted](const int key, std::string&& value) { evicted = std::to_string(key) + value; }));
+	assert(evicted == "3three" && map.size() == 2);
+
+	// random edits against a plain list of keys, front first
+	std::list<int> model = { 2, 1 };
+	std::uint32_t seed = 7;
+	for (int step = 0; step < 20000; ++step)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		const int key = static_cast<int>((seed >> 8) % 64);
+		auto found = std::find(model.begin(), model.end(), key);
+		switch ((seed >> 20) % 4)
+		{
+		case 0:
+			map.put(key, std::to_string(key));
+			if (found != model.end()) { model.erase(found); }
+			model.push_front(key);
+			break;
+		case 1:
+			assert(map.touch(key) == (found != model.end()));
+			if (found != model.end()) { model.erase(found); model.push_front(key); }
+			break;
+		case 2:
+			assert(map.erase(key) == (found != model.end()));
+			if (found != model.end()) { model.erase(found); }
+			break;
+		default:
+			assert(map.evict_back() == !model.empty());
+			if (!model.empty()) { model.pop_back(); }
+			break;
+		}
+
+		assert(map.size() == model.size());
+		assert(model.empty() || (map.front_key() == model.front() && map.back_key() == model.back()));
+		auto expected = model.begin();
+		map.for_each([&expected](const int k, const std::string&) { assert(k == *expected++); });
+	}
+
+	map.clear();
+	assert(map.empty() && !map.evict_back());
+}
+
+void LinkedListTest::relink_test()
+{
+	// the vector kernel has to agree with the plain loop for every tail length
+	struct Fake { intptr_t data[3]; intptr_t link; };
+	Fake nodes[40];
+	intptr_t addresses[42];
+	for (std::size_t n = 0; n <= 40; ++n)
+	{
+		addresses[0] = 0x1000;
+		addresses[n + 1] = 0;
+		for (std::size_t i = 1; i <= n; ++i)
+		{
+			addresses[i] = reinterpret_cast<intptr_t>(&nodes[(i * 7) % 40]);
+		}
+
+		xor_relink(addresses, n, offsetof(Fake, link));
+		for (std::size_t i = 1; i <= n; ++i)
+		{
+			assert(nodes[(i * 7) % 40].link == (addresses[i - 1] ^ addresses[i + 1]));
+		}
+	}
+
+	// runs longer than one batch, at both ends and in the middle
+	LinkedList<int> list(150, 1);
+	auto middle = list.begin();
+	std::advance(middle, 75);
+	list.insert(middle, 200, 2);
+	list.insert(list.begin(), 3, 0);
+	list.resize(500);
+	assert(list.size() == 500);
+
+	std::vector<int> expected(3, 0);
+	expected.insert(expected.end(), 75, 1);
+	expected.insert(expected.end(), 200, 2);
+	expected.insert(expected.end(), 75, 1);
+	expected.resize(500, 0);
+
+	const LinkedList<int> copy(list);
+	assert(std::equal(copy.begin(), copy.end(), expected.begin(), expected.end()));
+	auto it = copy.end();
+	for (auto i = expected.rbegin(); i != expected.rend(); ++i)
+	{
+		assert(*--it == *i);
+	}
+	assert(it == copy.begin());
+
+	// a count and a value of the element type are not an iterator range
+	LinkedList<int> sevens;
+	sevens.assign(3, 7);
+	sevens.insert(sevens.end(), 2, 7);
+	assert(sevens.size() == 5 && std::count(sevens.begin(), sevens.end(), 7) == 5);
+}
+
+void LinkedListTest::pmr_test()
+{
+#ifdef XOR_LIST_PMR
+	char buffer[4096];
+	std::pmr::monotonic_buffer_resource arena(buffer, sizeof(buffer), std::pmr::null_memory_resource());
+	std::pmr::unsynchronized_pool_resource pool;
+
+	pmr::LinkedList<int> list({ 1, 2, 3 }, &arena);
+	assert(list.get_allocator().resource() == &arena);
+	assert(std::equal(list.begin(), list.end(), must.begin(), must.end()));
+
+	// elements that take an allocator get the list's resource
+	pmr::LinkedList<std::pmr::string> strings(&arena);
+	strings.emplace_back("long enough to leave the small string buffer");
+	assert(strings.front().get_allocator().resource() == &arena);
+
+	// different resources: swap, assignment and splice move elements and keep the resources
+	pmr::LinkedList<int> other({ 4, 5 }, &pool);
+	list.swap(other);
+	assert(list.get_allocator().resource() == &arena && list.size() == 2 && list.front() == 4);
+	assert(other.get_allocator().resource() == &pool && other.size() == 3 && other.back() == 3);
+
+	list = other;
+	assert(list.get_allocator().resource() == &arena && list.size() == 3 && list.back() == 3);
+
+	list.splice(list.end(), other);
+	assert(list.size() == 6 && other.empty());
+
+	pmr::LinkedList<int> copy(list);
+	assert(copy.get_allocator().resource() == std::pmr::get_default_resource());
+
+	// the arena takes the nodes back at once
+	list.discard();
+	assert(list.empty());
+	list.push_back(7);
+	assert(list.front() == 7);
+
+	// the side state of the node cache and compact() comes from the list's resource too
+	struct CountingResource : std::pmr::memory_resource
+	{
+		std::size_t outstanding = 0;
+		void* do_allocate(std::size_t bytes, std::size_t alignment) override
+		{
+			outstanding += bytes;
+			return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+		}
+		void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+		{
+			outstanding -= bytes;
+			std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+		}
+		bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+	} counting;
+	{
+		pmr::LinkedList<int> counted({ 1, 2, 3 }, &counting);
+		const auto nodes = counting.outstanding;
+		counted.set_node_cache_capacity(4);
+		assert(counting.outstanding > nodes);
+		counted.compact();
+		counted.pop_front();
+		assert(counted.node_cache_size() == 3 && counted.front() == 2);
+	}
+	assert(counting.outstanding == 0);
+
+	// a moved small list keeps its resource and takes the heap nodes over
+	using PmrSmallList = SmallXorList<int, 2, std::pmr::polymorphic_allocator<int>>;
+	PmrSmallList small({ 1, 2, 3, 4 }, &pool);
+	const int* heap_node = &small.back();
+	PmrSmallList moved(std::move(small));
+	assert(moved.get_allocator().resource() == &pool && moved.size() == 4);
+	assert(&moved.back() == heap_node);
+	PmrSmallList copied(moved);
+	assert(copied.get_allocator().resource() == std::pmr::get_default_resource() && copied.size() == 4);
+#endif
+}
+
+void LinkedListTest::parallel_test()
+{
+	LinkedList<int> list;
+	for (int i = 0; i < 10000; ++i)
+	{
+		list.push_back(i);
+	}
+
+	ParallelPolicy policy;
+	policy.threads = 4;
+	policy.min_segment = 100;
+	list.parallel_for_each(policy, [](int& x) { x *= 2; });
+	auto sum = list.parallel_transform_reduce(policy, 0LL,
+		[](long long a, long long b) { return a + b; }, [](const int x) { return static_cast<long long>(x); });
+	assert(sum == 9999LL * 10000);
+
+	// the splits cover the list once, in order
+	auto splits = list.split_points(7);
+	assert(splits.size() == 8 && splits.front() == list.begin() && splits.back() == list.end());
+	auto count = list.parallel_transform_reduce(splits, std::size_t(0),
+		[](std::size_t a, std::size_t b) { return a + b; }, [](const int) { return std::size_t(1); });
+	assert(count == list.size());
+
+	// more threads than elements
+	LinkedList<int> small = { 1, 2, 3 };
+	policy.min_segment = 1;
+	policy.threads = 8;
+	assert(small.split_points(8).size() == 4);
+	assert(small.parallel_transform_reduce(policy, 10, [](int a, int b) { return a + b; }, [](int x) { return x; }) == 16);
+
+	LinkedList<int> empty;
+	empty.parallel_for_each(policy, [](int&) { assert(false); });
+	assert(empty.parallel_transform_reduce(policy, 5, [](int a, int b) { return a + b; }, [](int x) { return x; }) == 5);
+
+	bool thrown = false;
+	try
+	{
+		list.parallel_for_each(splits, [](int& x) { if (x == 15000) { throw std::runtime_error("stop"); } });
+	}
+	catch (const std::runtime_error&)
+	{
+		thrown = true;
+	}
+	assert(thrown);
+}
+
+void LinkedListTest::rcu_test()
+{
+	RcuXorList<int> rcu(4);
+	rcu.push_back(2);
+	rcu.push_back(3);
+	rcu.push_front(1);
+
+	auto reader = rcu.reader();
+	assert(reader.read([](const LinkedList<int>& list) { return equal(list, must); }));
+
+	// a reader inside read() keeps the list it loaded alive across writes
+	reader.read([&rcu](const LinkedList<int>& list) {
+		assert(rcu.erase(2) == 1 && rcu.erase(7) == 0);
+		assert(rcu.retired_lists() == 1);
+		assert(equal(list, must));
+	});
+	rcu.synchronize();
+	assert(rcu.retired_lists() == 0);
+
+	// a nested read doesn't end the protection of the outer one
+	rcu.update([](LinkedList<int>& list) { list.assign({ 1, 2, 3 }); });
+	reader.read([&rcu, &reader](const LinkedList<int>& list) {
+		rcu.erase(2);
+		assert(reader.read([](const LinkedList<int>& inner) { return inner.size() == 2; }));
+		rcu.push_back(2);
+		assert(rcu.retired_lists() == 2);
+		assert(equal(list, must));
+	});
+	rcu.synchronize();
+	assert(rcu.retired_lists() == 0);
+	rcu.erase(2);
+
+	LinkedList<int> more = { 4, 5 };
+	rcu.splice(more);
+	assert(more.empty());
+	assert(reader.read([](const LinkedList<int>& list) { return list.size() == 4 && list.back() == 5; }));
+
+	// readers must always see consecutive values while the writer appends and trims
+	rcu.erase_if([](int) { return true; });
+	std::atomic<bool> done(false);
+	std::vector<std::thread> readers;
+	for (int t = 0; t < 3; ++t)
+	{
+		readers.emplace_back([&rcu, &done] {
+			auto mine = rcu.reader();
+			while (!done.load())
+			{
+				mine.read([](const LinkedList<int>& list) {
+					int expected = list.empty() ? 0 : list.front();
+					for (auto x : list)
+					{
+						assert(x == expected++);
+					}
+				});
+			}
+		});
+	}
+
+	for (int i = 0; i < 2000; ++i)
+	{
+		rcu.push_back(i);
+		if (i % 3 == 0)
+		{
+			rcu.erase(i / 3);
+		}
+	}
+	done.store(true);
+	for (auto& r : readers)
+	{
+		r.join();
+	}
+
+	rcu.synchronize();
+	assert(reader.read([](const LinkedList<int>& list) { return list.size() == 1333 && list.front() == 667; }));
+}
+
+void LinkedListTest::split_partition_test()
+{
+	LinkedList<int> list = { 1, 2, 3, 4, 5, 6 };
+	auto position = list.begin();
+	std::advance(position, 3);
+	auto suffix = list.split_at(position, 3);
+	assert(equal(list, must));
+	assert(suffix.size() == 3 && suffix.front() == 4 && suffix.back() == 6);
+
+	auto all = suffix.split_at(suffix.begin());
+	assert(suffix.empty() && all.size() == 3);
+	assert(list.split_at(list.end()).empty() && list.size() == 3);
+
+	// inline nodes are copied out, the rest of the list keeps working
+	SmallXorList<int, 2> small = { 1, 2, 3, 4, 5, 6 };
+	auto tail = small.split_at(std::next(small.begin(), 2));
+	assert(small.size() == 2 && tail.size() == 4 && tail.front() == 3);
+	small.push_back(3);
+	assert(equal(static_cast<const LinkedList<int>&>(small), must));
+
+	LinkedList<int> numbers = { 1, 2, 3, 4, 5, 6, 7, 8 };
+	auto first_odd = numbers.stable_partition([](const int x) { return x % 2 == 0; });
+	const LinkedList<int> partitioned = { 2, 4, 6, 8, 1, 3, 5, 7 };
+	assert(equal(numbers, partitioned));
+	assert(*first_odd == 1 && *std::prev(first_odd) == 8);
+	assert(numbers.stable_partition([](int) { return true; }) == numbers.end());
+	assert(numbers.stable_partition([](int) { return false; }) == numbers.begin());
+
+	// a throwing predicate leaves every element in the list
+	try
+	{
+		numbers.stable_partition([](const int x) { if (x == 3) { throw std::runtime_error("stop"); } return x > 4; });
+	}
+	catch (const std::runtime_error&)
+	{
+	}
+	const LinkedList<int> interrupted = { 6, 8, 2, 4, 1, 3, 5, 7 };
+	assert(equal(numbers, interrupted));
+	auto it = numbers.end();
+	for (int n = 0; n < 8; ++n)
+	{
+		--it;
+	}
+	assert(it == numbers.begin());
+}
+
+void LinkedListTest::huge_page_pool_test()
+{
+	using HugePool = NodePool<node_pool_size<Node<int>>(), true>;
+	using HugeList = LinkedList<int, PoolAllocator<int, true>>;
+
+	HugeList list;
+	for (int i = 0; i < 1000; ++i)
+	{
+		list.push_back(i);
+	}
+	assert(list.size() == 1000 && list.back() == 999);
+	assert(HugePool::reserved_blocks() >= 1000);
+	assert(NodePool<node_pool_size<Node<int>>()>::mapped_slabs() == 0);
+	assert(NodePool<node_pool_size<Node<int>>()>::huge_page_slabs() == 0);
+	assert(HugePool::huge_page_slabs() <= HugePool::mapped_slabs());
+
+	// a mapped slab is a whole 2 MiB aligned region, operator new serves the pool when mmap fails
+	const auto mapped_blocks = HugePool::mapped_slabs() * (HugePool::huge_page_size / node_pool_size<Node<int>>());
+	assert(HugePool::reserved_blocks() >= mapped_blocks);
+	if (HugePool::reserved_blocks() == mapped_blocks)
+	{
+		const auto region = reinterpret_cast<std::uintptr_t>(&list.front()) / HugePool::huge_page_size;
+		assert(std::all_of(list.begin(), list.end(), [region](const int& x)
+			{ return reinterpret_cast<std::uintptr_t>(&x) / HugePool::huge_page_size == region; }));
+	}
+
+	// nodes move between lists of the same pool without copying
+	HugeList other = { -1 };
+	other.splice(other.end(), list);
+	assert(list.empty() && other.size() == 1001 && other.front() == -1);
+}
+
+void LinkedListTest::dedup_unordered_test()
+{
+	LinkedList<int> list = { 1, 2, 1, 1, 3, 2, 3, 1 };
+	assert(list.dedup_unordered() == 5);
+	assert(equal(list, must));
+	assert(list.dedup_unordered() == 0);
+	assert(equal(list, must));
+
+	// both ends go, the links around every removed run are rebuilt
+	LinkedList<int> ends = { 3, 3, 1, 3, 1, 2, 2, 1, 3 };
+	const LinkedList<int> kept = { 3, 1, 2 };
+	assert(ends.dedup_unordered() == 6);
+	assert(equal(ends, kept));
+	ends.reverse();
+	assert(ends.front() == 2 && ends.back() == 3);
+	ends.push_back(4);
+	assert(ends.size() == 4);
+
+	// more duplicates than a batch of freed nodes
+	LinkedList<int> same(1000, 7);
+	assert(same.dedup_unordered() == 999);
+	assert(same.size() == 1 && same.front() == 7 && same.back() == 7);
+
+	LinkedList<std::string> strings = { "Apple", "pear", "APPLE", "Pear", "plum" };
+	auto lower = [](std::string s) { std::transform(s.begin(), s.end(), s.begin(), ::tolower); return s; };
+	auto removed = strings.dedup_unordered([&lower](const std::string& s) { return std::hash<std::string>()(lower(s)); },
+		[&lower](const std::string& a, const std::string& b) { return lower(a) == lower(b); });
+	assert(removed == 2 && strings.size() == 3);
+	assert(strings.front() == "Apple" && *std::next(strings.begin()) == "pear" && strings.back() == "plum");
+
+	SmallXorList<int, 2> small = { 1, 1, 2, 2, 3 };
+	assert(small.dedup_unordered() == 2);
+	assert(equal(static_cast<const LinkedList<int>&>(small), must));
+
+	// a throwing hash keeps what was already removed and the rest as it was
+	LinkedList<int> interrupted = { 1, 1, 2, 2, 9, 2, 3 };
+	try
+	{
+		interrupted.dedup_unordered([](const int x) { if (x == 9) { throw std::runtime_error("stop"); } return std::hash<int>()(x); },
+			std::equal_to<int>());
+	}
+	catch (const std::runtime_error&)
+	{
+	}
+	const LinkedList<int> partial = { 1, 2, 9, 2, 3 };
+	assert(equal(interrupted, partial));
+	auto it = interrupted.end();
+	for (int n = 0; n < 5; ++n)
+	{
+		--it;
+	}
+	assert(it == interrupted.begin());
+}
@@ -26,6 +26,25 @@ private:
 	static void resize_test();
 	static void unique_test();
 	static void iterators_test();
+	static void node_cache_test();
+	static void small_list_test();
+	static void cursor_test();
+	static void channel_test();
+	static void static_list_test();
+	static void sorted_list_test();
+	static void node_pool_test();
+	static void bulk_pop_test();
+	static void move_only_test();
+	static void deferred_clear_test();
+	static void compact_test();
+	static void linked_hash_map_test();
+	static void relink_test();
+	static void pmr_test();
+	static void parallel_test();
+	static void rcu_test();
+	static void split_partition_test();
+	static void huge_page_pool_test();
+	static void dedup_unordered_test();
 
 private:
 	static const LinkedList<int> must;
@@ -0,0 +1,221 @@
+#include "NodePool.hpp"
+
+#if NODE_POOL_HUGE_PAGES
+#include <sys/mman.h>
+#endif
+
+template <std::size_t Size, bool HugePages>
+typename NodePool<Size, HugePages>::Depot& NodePool<Size, HugePages>::depot()
+{
+	// never destroyed: magazines of threads that outlive main still return to it
+	static Depot* instance = new Depot();
+	return *instance;
+}
+
+template <std::size_t Size, bool HugePages>
+typename NodePool<Size, HugePages>::Magazine& NodePool<Size, HugePages>::magazine()
+{
+	thread_local Magazine instance;
+	return instance;
+}
+
+template <std::size_t Size, bool HugePages>
+NodePool<Size, HugePages>::Magazine::~Magazine()
+{
+	// hand the blocks of an exiting thread back in full magazines
+	while (nullptr != blocks)
+	{
+		auto first = blocks;
+		auto last = first;
+		for (std::size_t i = 1; i < magazine_size && nullptr != last->link.next; ++i)
+		{
+			last = last->link.next;
+		}
+		blocks = last->link.next;
+		last->link.next = nullptr;
+		depot().give(first);
+	}
+	count = 0;
+}
+
+template <std::size_t Size, bool HugePages>
+typename NodePool<Size, HugePages>::Block* NodePool<Size, HugePages>::Depot::take()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (nullptr == magazines)
+	{
+		auto magazine_count = slab_magazines;
+		Block* slab = nullptr;
+		if (HugePages)
+		{
+			slab = map_huge_slab();
+			if (nullptr != slab)
+			{
+				++mapped;
+				magazine_count = huge_page_size / (magazine_size * sizeof(Block));
+			}
+		}
+		if (nullptr == slab)
+		{
+			slab = static_cast<Block*>(::operator new(magazine_count * magazine_size * sizeof(Block)));
+		}
+		slabs.push_back(slab);
+		reserved += magazine_count * magazine_size;
+		for (std::size_t m = 0; m < magazine_count; ++m)
+		{
+			auto first = slab + m * magazine_size;
+			for (std::size_t i = 0; i + 1 < magazine_size; ++i)
+			{
+				first[i].link.next = first + i + 1;
+			}
+			first[magazine_size - 1].link.next = nullptr;
+			first->link.magazine = magazines;
+			magazines = first;
+		}
+	}
+
+	auto magazine = magazines;
+	magazines = magazine->link.magazine;
+	return magazine;
+}
+
+template <std::size_t Size, bool HugePages>
+typename NodePool<Size, HugePages>::Block* NodePool<Size, HugePages>::Depot::map_huge_slab()
+{
+#if NODE_POOL_HUGE_PAGES && defined(MADV_HUGEPAGE)
+	if (huge_page_size < magazine_size * sizeof(Block))
+	{
+		return nullptr;
+	}
+
+	// map twice the size and trim, mmap only promises page alignment
+	const auto length = 2 * huge_page_size;
+	void* const mapped = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (MAP_FAILED == mapped)
+	{
+		return nullptr;
+	}
+
+	const auto begin = reinterpret_cast<std::uintptr_t>(mapped);
+	const auto aligned = (begin + huge_page_size - 1) & ~(huge_page_size - 1);
+	if (aligned != begin)
+	{
+		::munmap(mapped, aligned - begin);
+	}
+	if (aligned + huge_page_size != begin + length)
+	{
+		::munmap(reinterpret_cast<void*>(aligned + huge_page_size), begin + length - aligned - huge_page_size);
+	}
+
+	// THP disabled or not built in: the mapping still works with small pages
+	if (0 == ::madvise(reinterpret_cast<void*>(aligned), huge_page_size, MADV_HUGEPAGE))
+	{
+		++huge_slabs;
+	}
+	return reinterpret_cast<Block*>(aligned);
+#else
+	return nullptr;
+#endif
+}
+
+template <std::size_t Size, bool HugePages>
+void NodePool<Size, HugePages>::Depot::give(Block* const magazine)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	magazine->link.magazine = magazines;
+	magazines = magazine;
+}
+
+template <std::size_t Size, bool HugePages>
+void* NodePool<Size, HugePages>::allocate()
+{
+	auto& local = magazine();
+	if (nullptr == local.blocks)
+	{
+		// a magazine from the depot may be short if a thread returned a partial one
+		local.blocks = depot().take();
+		local.count = 0;
+		for (auto b = local.blocks; nullptr != b; b = b->link.next)
+		{
+			++local.count;
+		}
+	}
+
+	auto block = local.blocks;
+	local.blocks = block->link.next;
+	--local.count;
+	return block;
+}
+
+template <std::size_t Size, bool HugePages>
+void NodePool<Size, HugePages>::deallocate(void* const p) noexcept
+{
+	auto& local = magazine();
+	auto block = static_cast<Block*>(p);
+	block->link.next = local.blocks;
+	local.blocks = block;
+	++local.count;
+
+	if (local.count < 2 * magazine_size)
+	{
+		return;
+	}
+
+	// keep one magazine, give the other one back
+	auto last = local.blocks;
+	for (std::size_t i = 1; i < magazine_size; ++i)
+	{
+		last = last->link.next;
+	}
+	auto spare = last->link.next;
+	last->link.next = nullptr;
+	local.count = magazine_size;
+	depot().give(spare);
+}
+
+template <std::size_t Size, bool HugePages>
+std::size_t NodePool<Size, HugePages>::reserved_blocks()
+{
+	auto& d = depot();
+	std::lock_guard<std::mutex> lock(d.mutex);
+	return d.reserved;
+}
+
+template <std::size_t Size, bool HugePages>
+std::size_t NodePool<Size, HugePages>::mapped_slabs()
+{
+	auto& d = depot();
+	std::lock_guard<std::mutex> lock(d.mutex);
+	return d.mapped;
+}
+
+template <std::size_t Size, bool HugePages>
+std::size_t NodePool<Size, HugePages>::huge_page_slabs()
+{
+	auto& d = depot();
+	std::lock_guard<std::mutex> lock(d.mutex);
+	return d.huge_slabs;
+}
+
+template <class T, bool HugePages>
+T* PoolAllocator<T, HugePages>::allocate(const std::size_t n)
+{
+	if (n != 1)
+	{
+		return static_cast<T*>(::operator new(n * sizeof(T)));
+	}
+
+	return static_cast<T*>(NodePool<node_pool_size<T>(), HugePages>::allocate());
+}
+
+template <class T, bool HugePages>
+void PoolAllocator<T, HugePages>::deallocate(T* const p, const std::size_t n) noexcept
+{
+	if (n != 1)
+	{
+		::operator delete(p);
+		return;
+	}
+
+	NodePool<node_pool_size<T>(), HugePages>::deallocate(p);
+}
@@ -0,0 +1,149 @@
+#ifndef _NODE_POOL_H_
+#define _NODE_POOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+/*
+	Pool for fixed size blocks shared by every list in the process
+	Blocks are grouped by size class, so nodes of different element types
+	with the same rounded size come from the same pool
+	Each thread keeps a magazine of free blocks and trades whole magazines
+	with a global depot, so the mutex is taken once per magazine_size operations
+	A block may be freed by any thread, it simply joins that thread's magazine
+	Memory is kept for reuse and never returned to the system
+	With HugePages every slab is a 2 MiB aligned mapping advised for transparent huge pages,
+	so a long traversal touches one TLB entry per 2 MiB instead of one per 4 KiB;
+	where that is not available the slab comes from operator new as usual
+*/
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<sys/mman.h>)
+#define NODE_POOL_HUGE_PAGES 1
+#endif
+#endif
+
+template <std::size_t Size, bool HugePages = false>
+class NodePool
+{
+	static_assert(Size % alignof(std::max_align_t) == 0, "NodePool size classes are multiples of max_align_t");
+
+public:
+	static constexpr std::size_t magazine_size = 64;
+	static constexpr std::size_t slab_magazines = 16;
+	static constexpr std::size_t huge_page_size = std::size_t(2) << 20;
+
+public:
+	static void* allocate();
+	static void deallocate(void* const p) noexcept;
+
+	// blocks ever carved from the system, for tests and benchmarks
+	static std::size_t reserved_blocks();
+
+	// slabs mapped as 2 MiB aligned regions, 0 without HugePages or when mmap failed
+	// and operator new served them instead
+	static std::size_t mapped_slabs();
+
+	// mapped slabs the kernel accepted the huge page advice for
+	// whether it backs them with huge pages is up to its THP setting
+	static std::size_t huge_page_slabs();
+
+private:
+	union Block;
+
+	struct Link
+	{
+		Block* next;      /* next block in the magazine */
+		Block* magazine;  /* next magazine in the depot, only set on the first block */
+	};
+
+	union Block
+	{
+		Link link;
+		typename std::aligned_storage<Size, alignof(std::max_align_t)>::type storage;
+	};
+
+	struct Magazine
+	{
+		Block* blocks = nullptr;
+		std::size_t count = 0;
+
+		~Magazine();
+	};
+
+	struct Depot
+	{
+		std::mutex mutex;
+		Block* magazines = nullptr;
+		std::vector<Block*> slabs;
+		std::size_t reserved = 0;
+		std::size_t mapped = 0;
+		std::size_t huge_slabs = 0;
+
+		// a full magazine, carving a new slab if there is none
+		Block* take();
+		// a huge page mapping, nullptr if the system refuses
+		Block* map_huge_slab();
+		void give(Block* const magazine);
+	};
+
+	static Depot& depot();
+	static Magazine& magazine();
+};
+
+// size class of T, blocks are at least two pointers big
+template <class T>
+constexpr std::size_t node_pool_size()
+{
+	return ((sizeof(T) < 2 * sizeof(void*) ? 2 * sizeof(void*) : sizeof(T)) + alignof(std::max_align_t) - 1)
+		/ alignof(std::max_align_t) * alignof(std::max_align_t);
+}
+
+/*
+	Allocator over NodePool, use it as LinkedList<T, PoolAllocator<T>>
+	All instances are equal, so nodes can move between lists with splice and merge
+	and be freed by any list on any thread
+	Requests for more than one object go to operator new
+	PoolAllocator<T, true> takes its nodes from the huge page pools
+*/
+
+template <class T, bool HugePages = false>
+class PoolAllocator
+{
+	static_assert(alignof(T) <= alignof(std::max_align_t), "PoolAllocator doesn't support over-aligned types");
+
+public:
+	using value_type = T;
+	using is_always_equal = std::true_type;
+	using propagate_on_container_move_assignment = std::true_type;
+
+	template <class U>
+	struct rebind
+	{
+		using other = PoolAllocator<U, HugePages>;
+	};
+
+public:
+	PoolAllocator() noexcept {}
+
+	template <class U>
+	PoolAllocator(const PoolAllocator<U, HugePages>&) noexcept {}
+
+	T* allocate(const std::size_t n);
+	void deallocate(T* const p, const std::size_t n) noexcept;
+};
+
+template <class T, class U, bool HugePages>
+bool operator==(const PoolAllocator<T, HugePages>&, const PoolAllocator<U, HugePages>&) noexcept { return true; }
+
+template <class T, class U, bool HugePages>
+bool operator!=(const PoolAllocator<T, HugePages>&, const PoolAllocator<U, HugePages>&) noexcept { return false; }
+
+#include "NodePool-inl.hpp"
+
+#endif /* _NODE_POOL_H_ */
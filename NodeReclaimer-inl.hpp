@@ -0,0 +1,99 @@
+#include "NodeReclaimer.hpp"
+#include <utility>
+
+inline NodeReclaimer::NodeReclaimer()
+	: pending_nodes(0)
+	, stopping(false)
+{}
+
+inline NodeReclaimer::~NodeReclaimer()
+{
+	stop();
+	while (reclaim(static_cast<std::size_t>(-1)) > 0)
+	{
+	}
+}
+
+inline void NodeReclaimer::retire(std::unique_ptr<Chain> chain, const std::size_t nodes)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		chains.push_back(std::move(chain));
+		pending_nodes.fetch_add(nodes, std::memory_order_relaxed);
+	}
+	retired.notify_one();
+}
+
+inline std::size_t NodeReclaimer::reclaim(const std::size_t budget)
+{
+	std::size_t freed = 0;
+	while (freed < budget)
+	{
+		std::unique_ptr<Chain> chain;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (chains.empty())
+			{
+				break;
+			}
+			chain = std::move(chains.back());
+			chains.pop_back();
+		}
+
+		// free outside the lock so retire() never waits for a slice
+		auto n = chain->reclaim(budget - freed);
+		freed += n;
+		pending_nodes.fetch_sub(n, std::memory_order_relaxed);
+
+		if (!chain->empty())
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			chains.push_back(std::move(chain));
+		}
+	}
+
+	return freed;
+}
+
+inline void NodeReclaimer::start(const std::size_t slice_nodes)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (worker.joinable())
+	{
+		return;
+	}
+
+	stopping = false;
+	worker = std::thread(&NodeReclaimer::run, this, slice_nodes);
+}
+
+inline void NodeReclaimer::stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	retired.notify_all();
+
+	if (worker.joinable())
+	{
+		worker.join();
+	}
+}
+
+inline void NodeReclaimer::run(const std::size_t slice_nodes)
+{
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			retired.wait(lock, [this] { return stopping || !chains.empty(); });
+			if (stopping)
+			{
+				return;
+			}
+		}
+
+		reclaim(slice_nodes);
+	}
+}
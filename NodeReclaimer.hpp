@@ -0,0 +1,68 @@
+#ifndef _NODE_RECLAIMER_H_
+#define _NODE_RECLAIMER_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+	Takes detached node chains off the latency critical path
+	A list with a reclaimer set hands its whole chain over in O(1) on clear() and destruction
+	and the nodes are destroyed later, either by reclaim(budget) calls
+	or by a background thread started with start()
+	The allocator a chain came from must outlive its reclamation
+*/
+
+class NodeReclaimer
+{
+public:
+	// a retired run of nodes that knows how to free itself
+	class Chain
+	{
+	public:
+		virtual ~Chain() {}
+
+		// frees up to budget nodes, returns how many were freed
+		virtual std::size_t reclaim(std::size_t budget) = 0;
+		virtual bool empty() const noexcept = 0;
+	};
+
+public:
+	NodeReclaimer();
+	NodeReclaimer(const NodeReclaimer&) = delete;
+	NodeReclaimer& operator=(const NodeReclaimer&) = delete;
+
+	// frees everything still pending
+	~NodeReclaimer();
+
+	void retire(std::unique_ptr<Chain> chain, const std::size_t nodes);
+
+	// frees up to budget nodes on the calling thread, returns how many were freed
+	std::size_t reclaim(const std::size_t budget);
+
+	// background thread freeing slice_nodes at a time until stop()
+	void start(const std::size_t slice_nodes = 4096);
+	void stop();
+
+	std::size_t pending() const noexcept { return pending_nodes.load(std::memory_order_relaxed); }
+
+private:
+	void run(const std::size_t slice_nodes);
+
+private:
+	std::mutex mutex;
+	std::condition_variable retired;
+	std::vector<std::unique_ptr<Chain>> chains;
+	std::atomic<std::size_t> pending_nodes;
+
+	std::thread worker;
+	bool stopping;
+};
+
+#include "NodeReclaimer-inl.hpp"
+
+#endif /* _NODE_RECLAIMER_H_ */
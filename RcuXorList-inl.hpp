@@ -0,0 +1,206 @@
+#include "RcuXorList.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+template <class T, class TAllocator>
+RcuXorList<T, TAllocator>::RcuXorList(const std::size_t reader_slots, const TAllocator& alloc)
+	: current(new list_type(alloc))
+	, epoch(1)
+	, slots(new Slot[reader_slots])
+	, slot_count(reader_slots)
+{
+	for (std::size_t i = 0; i < slot_count; ++i)
+	{
+		slots[i].epoch.store(0, std::memory_order_relaxed);
+		slots[i].taken.store(false, std::memory_order_relaxed);
+		slots[i].depth = 0;
+	}
+}
+
+template <class T, class TAllocator>
+RcuXorList<T, TAllocator>::~RcuXorList()
+{
+	delete current.load(std::memory_order_relaxed);
+}
+
+template <class T, class TAllocator>
+RcuXorList<T, TAllocator>::Reader::~Reader()
+{
+	if (nullptr != slot)
+	{
+		slot->epoch.store(0, std::memory_order_release);
+		slot->taken.store(false, std::memory_order_release);
+	}
+}
+
+template <class T, class TAllocator>
+template <class F>
+auto RcuXorList<T, TAllocator>::Reader::read(F f) -> decltype(f(std::declval<const list_type&>()))
+{
+	// announce the epoch before looking at the list: a writer that misses the announcement
+	// has already published the list this reader is going to load
+	// a nested read keeps the outermost epoch, which is older and so protects its list too
+	if (slot->depth++ == 0)
+	{
+		slot->epoch.store(owner->epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+	}
+	const list_type* list = owner->current.load(std::memory_order_seq_cst);
+
+	struct Leave
+	{
+		Slot* slot;
+		~Leave()
+		{
+			if (--slot->depth == 0)
+			{
+				slot->epoch.store(0, std::memory_order_release);
+			}
+		}
+	} leave{ slot };
+
+	return f(*list);
+}
+
+template <class T, class TAllocator>
+typename RcuXorList<T, TAllocator>::Reader RcuXorList<T, TAllocator>::reader()
+{
+	for (std::size_t i = 0; i < slot_count; ++i)
+	{
+		bool expected = false;
+		if (slots[i].taken.compare_exchange_strong(expected, true, std::memory_order_acquire))
+		{
+			return Reader(this, &slots[i]);
+		}
+	}
+
+	throw std::length_error("RcuXorList: no free reader slot");
+}
+
+template <class T, class TAllocator>
+template <class F>
+void RcuXorList<T, TAllocator>::update(F f)
+{
+	std::lock_guard<std::mutex> lock(write_mutex);
+	std::unique_ptr<list_type> next(new list_type(*current.load(std::memory_order_relaxed)));
+	f(*next);
+	publish(std::move(next));
+}
+
+template <class T, class TAllocator>
+void RcuXorList<T, TAllocator>::publish(std::unique_ptr<list_type> next)
+{
+	// no allocation may fail once the old list is out
+	retired.reserve(retired.size() + 1);
+	std::unique_ptr<list_type> old(current.exchange(next.release(), std::memory_order_seq_cst));
+
+	// readers announcing this epoch or a later one load the new list
+	auto retire_epoch = epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+	retired.push_back(Retired{ std::move(old), retire_epoch });
+	collect();
+}
+
+template <class T, class TAllocator>
+typename RcuXorList<T, TAllocator>::size_type RcuXorList<T, TAllocator>::collect()
+{
+	auto oldest = static_cast<std::uint64_t>(-1);
+	for (std::size_t i = 0; i < slot_count; ++i)
+	{
+		auto reading = slots[i].epoch.load(std::memory_order_seq_cst);
+		if (reading != 0 && reading < oldest)
+		{
+			oldest = reading;
+		}
+	}
+
+	size_type kept = 0;
+	for (auto& r : retired)
+	{
+		if (r.epoch > oldest)
+		{
+			retired[kept++] = std::move(r);
+		}
+	}
+	retired.resize(kept);
+	return kept;
+}
+
+template <class T, class TAllocator>
+void RcuXorList<T, TAllocator>::synchronize()
+{
+	for (;;)
+	{
+		{
+			std::lock_guard<std::mutex> lock(write_mutex);
+			if (collect() == 0)
+			{
+				return;
+			}
+		}
+		std::this_thread::yield();
+	}
+}
+
+template <class T, class TAllocator>
+typename RcuXorList<T, TAllocator>::size_type RcuXorList<T, TAllocator>::retired_lists() const
+{
+	std::lock_guard<std::mutex> lock(write_mutex);
+	return retired.size();
+}
+
+template <class T, class TAllocator>
+void RcuXorList<T, TAllocator>::push_back(const T& value)
+{
+	update([&value](list_type& list) { list.push_back(value); });
+}
+
+template <class T, class TAllocator>
+void RcuXorList<T, TAllocator>::push_front(const T& value)
+{
+	update([&value](list_type& list) { list.push_front(value); });
+}
+
+template <class T, class TAllocator>
+typename RcuXorList<T, TAllocator>::size_type RcuXorList<T, TAllocator>::erase(const T& value)
+{
+	return erase_if([&value](const T& x) { return x == value; });
+}
+
+template <class T, class TAllocator>
+template <class Predicate>
+typename RcuXorList<T, TAllocator>::size_type RcuXorList<T, TAllocator>::erase_if(Predicate pred)
+{
+	std::lock_guard<std::mutex> lock(write_mutex);
+
+	// nothing to erase, nothing to publish
+	const list_type& now = *current.load(std::memory_order_relaxed);
+	if (std::none_of(now.begin(), now.end(), pred))
+	{
+		return 0;
+	}
+
+	std::unique_ptr<list_type> next(new list_type(now));
+	size_type erased = 0;
+	for (typename list_type::const_iterator it = next->begin(); it != next->end();)
+	{
+		if (pred(*it))
+		{
+			it = next->erase(it);
+			++erased;
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	publish(std::move(next));
+	return erased;
+}
+
+template <class T, class TAllocator>
+void RcuXorList<T, TAllocator>::splice(list_type& x)
+{
+	update([&x](list_type& list) { list.splice(list.end(), x); });
+}
@@ -0,0 +1,120 @@
+#ifndef _RCU_XOR_LIST_H_
+#define _RCU_XOR_LIST_H_
+
+#include "LinkedList.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/*
+	LinkedList for many concurrent readers and one writer at a time
+	Updating XOR links in place would let a reader decode a link with a neighbour
+	that changed under it, so the writer never touches a published list:
+	every update is applied to a copy that is then published with one pointer store
+	Readers take no lock, they announce the epoch they started in on a slot of their own
+	and a replaced list is freed once no reader that could still see it is left
+	Writes cost a copy of the list, batch them with update() when there are several
+*/
+
+template < class T, class TAllocator = std::allocator<T> >
+class RcuXorList
+{
+public:
+	using list_type = LinkedList<T, TAllocator>;
+	using value_type = T;
+	using size_type = typename list_type::size_type;
+
+	static constexpr std::size_t default_reader_slots = 64;
+
+private:
+	struct alignas(64) Slot
+	{
+		std::atomic<std::uint64_t> epoch; /* 0 while not reading */
+		std::atomic<bool> taken;
+		std::size_t depth; /* nested reads on the owning thread */
+	};
+
+public:
+	// a reader slot, keep one per reading thread for as long as the thread reads
+	class Reader
+	{
+	public:
+		Reader(Reader&& other) noexcept : owner(other.owner), slot(other.slot) { other.slot = nullptr; }
+		Reader(const Reader&) = delete;
+		Reader& operator=(const Reader&) = delete;
+		~Reader();
+
+		// calls f(const list_type&) on the current list, which stays alive until f returns
+		// f may read again through the same reader, the outer epoch keeps protecting both lists
+		template <class F>
+		auto read(F f) -> decltype(f(std::declval<const list_type&>()));
+
+	private:
+		friend class RcuXorList;
+		Reader(RcuXorList* const _owner, Slot* const _slot) : owner(_owner), slot(_slot) {}
+
+		RcuXorList* owner;
+		Slot* slot;
+	};
+
+public:
+	explicit RcuXorList(const std::size_t reader_slots = default_reader_slots, const TAllocator& alloc = TAllocator());
+
+	RcuXorList(const RcuXorList&) = delete;
+	RcuXorList& operator=(const RcuXorList&) = delete;
+
+	// no reader may be active any more
+	~RcuXorList();
+
+	// throws std::length_error when every slot is taken
+	Reader reader();
+
+	// writers, serialized among themselves, each publishes a new list
+	void push_back(const T& value);
+	void push_front(const T& value);
+
+	// erases every element equal to value or matching pred, returns how many were erased
+	size_type erase(const T& value);
+	template <class Predicate>
+	size_type erase_if(Predicate pred);
+
+	// moves the elements of x to the back
+	void splice(list_type& x);
+
+	// applies f(list_type&) to a copy of the current list and publishes the result
+	template <class F>
+	void update(F f);
+
+	// waits until every replaced list has been freed
+	void synchronize();
+
+	size_type retired_lists() const;
+
+private:
+	struct Retired
+	{
+		std::unique_ptr<list_type> list;
+		std::uint64_t epoch; /* free once every reader is past it */
+	};
+
+	void publish(std::unique_ptr<list_type> next);
+
+	// frees the retired lists no reader can see, returns how many are left
+	size_type collect();
+
+private:
+	std::atomic<list_type*> current;
+	std::atomic<std::uint64_t> epoch;
+	std::unique_ptr<Slot[]> slots;
+	std::size_t slot_count;
+
+	mutable std::mutex write_mutex;
+	std::vector<Retired> retired;
+};
+
+#include "RcuXorList-inl.hpp"
+
+#endif /* _RCU_XOR_LIST_H_ */
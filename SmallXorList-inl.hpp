@@ -0,0 +1,61 @@
+#include "SmallXorList.hpp"
+#include <memory>
+#include <utility>
+
+template <class T, std::size_t N, class TAllocator>
+SmallXorList<T, N, TAllocator>::SmallXorList(const allocator_type& alloc)
+	: InlineNodeStorage<T, N>()
+	, base_type(&this->inline_extras, this->inline_nodes(), N, alloc)
+{}
+
+template <class T, std::size_t N, class TAllocator>
+SmallXorList<T, N, TAllocator>::SmallXorList(std::initializer_list<value_type> il, const allocator_type& alloc)
+	: SmallXorList(alloc)
+{
+	base_type::assign(il);
+}
+
+template <class T, std::size_t N, class TAllocator>
+SmallXorList<T, N, TAllocator>::SmallXorList(const size_type n, const_reference val, const allocator_type& alloc)
+	: SmallXorList(alloc)
+{
+	base_type::assign(n, val);
+}
+
+template <class T, std::size_t N, class TAllocator>
+SmallXorList<T, N, TAllocator>::SmallXorList(const SmallXorList& other)
+	: SmallXorList(std::allocator_traits<allocator_type>::select_on_container_copy_construction(other.get_allocator()))
+{
+	base_type::assign(other.begin(), other.end());
+}
+
+template <class T, std::size_t N, class TAllocator>
+SmallXorList<T, N, TAllocator>::SmallXorList(SmallXorList&& other)
+	: SmallXorList(other.get_allocator())
+{
+	// the heap nodes are taken over, only the inline ones are moved element by element
+	base_type::splice(base_type::end(), other);
+}
+
+template <class T, std::size_t N, class TAllocator>
+SmallXorList<T, N, TAllocator>& SmallXorList<T, N, TAllocator>::operator=(const SmallXorList& right)
+{
+	if (&right != this)
+	{
+		base_type::assign(right.begin(), right.end());
+	}
+
+	return *this;
+}
+
+template <class T, std::size_t N, class TAllocator>
+SmallXorList<T, N, TAllocator>& SmallXorList<T, N, TAllocator>::operator=(SmallXorList&& right)
+{
+	if (&right != this)
+	{
+		base_type::clear();
+		base_type::splice(base_type::end(), right);
+	}
+
+	return *this;
+}
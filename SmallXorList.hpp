@@ -0,0 +1,59 @@
+#ifndef _SMALL_XOR_LIST_H_
+#define _SMALL_XOR_LIST_H_
+
+#include "LinkedList.hpp"
+#include <cstddef>
+#include <type_traits>
+
+namespace
+{
+	// lives in a base class so the buffer is constructed before LinkedList sees it
+	template <class T, std::size_t N>
+	struct InlineNodeStorage
+	{
+		typename std::aligned_storage<sizeof(Node<T>), alignof(Node<T>)>::type nodes[N];
+		ListExtras<T> inline_extras;
+
+		Node<T>* inline_nodes() noexcept { return reinterpret_cast<Node<T>*>(nodes); }
+	};
+}
+
+/*
+	LinkedList that keeps its first N nodes inside the object
+	and goes to the allocator only when it grows beyond that
+	Inline nodes never leave the list: moving, swapping or splicing them
+	into another list moves the elements instead
+*/
+
+template < class T, std::size_t N, class TAllocator = std::allocator<T> >
+class SmallXorList : private InlineNodeStorage<T, N>, public LinkedList<T, TAllocator>
+{
+	static_assert(N > 0, "SmallXorList needs at least one inline node");
+	static_assert(std::is_move_constructible<T>::value, "inline nodes hand their elements over by moving them");
+
+public:
+	using base_type = LinkedList<T, TAllocator>;
+	using typename base_type::allocator_type;
+	using typename base_type::value_type;
+	using typename base_type::const_reference;
+	using typename base_type::size_type;
+
+public:
+	SmallXorList() : SmallXorList(allocator_type()) {}
+	explicit SmallXorList(const allocator_type& alloc);
+
+	SmallXorList(std::initializer_list<value_type> il, const allocator_type& alloc = allocator_type());
+	SmallXorList(const size_type n, const_reference val, const allocator_type& alloc = allocator_type());
+
+	SmallXorList(const SmallXorList& other);
+	SmallXorList(SmallXorList&& other);
+
+	SmallXorList& operator=(const SmallXorList& right);
+	SmallXorList& operator=(SmallXorList&& right);
+
+	static constexpr size_type inline_capacity() noexcept { return N; }
+};
+
+#include "SmallXorList-inl.hpp"
+
+#endif /* _SMALL_XOR_LIST_H_ */
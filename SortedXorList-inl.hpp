@@ -0,0 +1,164 @@
+#include "SortedXorList.hpp"
+#include <iterator>
+
+template <class T, class Compare, class TAllocator>
+SortedXorList<T, Compare, TAllocator>::SortedXorList(const Compare& _comp, const TAllocator& alloc)
+	: items(alloc)
+	, comp(_comp)
+	, header()
+	, levels(0)
+	, seed(2463534242u)
+{
+	header.next.assign(max_levels, nullptr);
+}
+
+template <class T, class Compare, class TAllocator>
+SortedXorList<T, Compare, TAllocator>::~SortedXorList() { clear(); }
+
+template <class T, class Compare, class TAllocator>
+void SortedXorList<T, Compare, TAllocator>::clear()
+{
+	auto finger = header.next[0];
+	while (nullptr != finger)
+	{
+		auto next = finger->next[0];
+		delete finger;
+		finger = next;
+	}
+	header.next.assign(max_levels, nullptr);
+	levels = 0;
+	items.clear();
+}
+
+template <class T, class Compare, class TAllocator>
+std::size_t SortedXorList<T, Compare, TAllocator>::random_levels()
+{
+	// xorshift32
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+
+	// one node in four gets a finger, each further level halves that
+	if ((seed & 3) != 0)
+	{
+		return 0;
+	}
+
+	std::size_t n = 1;
+	for (auto bits = seed >> 2; (bits & 1) != 0 && n < max_levels; bits >>= 1)
+	{
+		++n;
+	}
+	return n;
+}
+
+template <class T, class Compare, class TAllocator>
+template <class Before>
+typename SortedXorList<T, Compare, TAllocator>::const_iterator SortedXorList<T, Compare, TAllocator>::search(
+	const_reference key, Before before, Finger** const update) const
+{
+	auto x = &header;
+	for (auto l = levels; l > 0; --l)
+	{
+		while (nullptr != x->next[l - 1] && before(*x->next[l - 1]->position, key))
+		{
+			x = x->next[l - 1];
+		}
+		update[l - 1] = x;
+	}
+
+	auto i = (x == &header) ? items.begin() : x->position;
+	auto last = items.end();
+	while (i != last && before(*i, key))
+	{
+		++i;
+	}
+	return i;
+}
+
+template <class T, class Compare, class TAllocator>
+typename SortedXorList<T, Compare, TAllocator>::const_iterator SortedXorList<T, Compare, TAllocator>::lower_bound(const_reference key) const
+{
+	Finger* update[max_levels];
+	return search(key, [this](const_reference a, const_reference b) { return comp(a, b); }, update);
+}
+
+template <class T, class Compare, class TAllocator>
+typename SortedXorList<T, Compare, TAllocator>::const_iterator SortedXorList<T, Compare, TAllocator>::upper_bound(const_reference key) const
+{
+	Finger* update[max_levels];
+	return search(key, [this](const_reference a, const_reference b) { return !comp(b, a); }, update);
+}
+
+template <class T, class Compare, class TAllocator>
+typename SortedXorList<T, Compare, TAllocator>::const_iterator SortedXorList<T, Compare, TAllocator>::insert_sorted(const_reference value)
+{
+	Finger* update[max_levels];
+	auto position = search(value, [this](const_reference a, const_reference b) { return !comp(b, a); }, update);
+	const_iterator inserted = items.insert(position, value);
+
+	// the node after the new one has a new previous, fix its finger if it has one
+	auto successor = (levels > 0) ? update[0]->next[0] : nullptr;
+	if (nullptr != successor && successor->position == position)
+	{
+		successor->position = std::next(inserted);
+	}
+
+	auto height = random_levels();
+	if (height == 0)
+	{
+		return inserted;
+	}
+
+	for (; levels < height; ++levels)
+	{
+		update[levels] = &header;
+	}
+
+	auto finger = new Finger{ inserted, std::vector<Finger*>(height, nullptr) };
+	for (std::size_t l = 0; l < height; ++l)
+	{
+		finger->next[l] = update[l]->next[l];
+		update[l]->next[l] = finger;
+	}
+
+	return inserted;
+}
+
+template <class T, class Compare, class TAllocator>
+typename SortedXorList<T, Compare, TAllocator>::size_type SortedXorList<T, Compare, TAllocator>::erase(const_reference key)
+{
+	Finger* update[max_levels];
+	auto position = search(key, [this](const_reference a, const_reference b) { return comp(a, b); }, update);
+
+	size_type erased = 0;
+	while (position != items.end() && !comp(key, *position))
+	{
+		auto successor = (levels > 0) ? update[0]->next[0] : nullptr;
+		if (nullptr != successor && successor->position == position)
+		{
+			for (std::size_t l = 0; l < successor->next.size(); ++l)
+			{
+				update[l]->next[l] = successor->next[l];
+			}
+			delete successor;
+			successor = (levels > 0) ? update[0]->next[0] : nullptr;
+		}
+
+		position = items.erase(position);
+		++erased;
+
+		// the next node lost its previous, fix its finger if it has one
+		if (nullptr != successor && successor->position == position)
+		{
+			successor->position = position;
+		}
+	}
+
+	while (levels > 0 && nullptr == header.next[levels - 1])
+	{
+		--levels;
+	}
+
+	return erased;
+}
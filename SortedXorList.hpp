@@ -0,0 +1,83 @@
+#ifndef _SORTED_XOR_LIST_H_
+#define _SORTED_XOR_LIST_H_
+
+#include "LinkedList.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/*
+	LinkedList kept in Compare order with a sparse skip layer on top
+	About one node in four carries a finger: a stored iterator, i.e. the (node, previous) pair,
+	linked into skip list levels. Searches descend the fingers and finish with a short walk
+	over the XOR chain, so insert_sorted, lower_bound, upper_bound and erase(key)
+	take expected O(log n) while the base level keeps the compact XOR nodes
+	Equal elements keep insertion order
+*/
+
+template < class T, class Compare = std::less<T>, class TAllocator = std::allocator<T> >
+class SortedXorList
+{
+public:
+	using list_type = LinkedList<T, TAllocator>;
+	using value_type = T;
+	using size_type = typename list_type::size_type;
+	using const_reference = typename list_type::const_reference;
+	using const_iterator = typename list_type::const_iterator;
+
+	static constexpr std::size_t max_levels = 24;
+
+public:
+	explicit SortedXorList(const Compare& comp = Compare(), const TAllocator& alloc = TAllocator());
+
+	SortedXorList(const SortedXorList&) = delete;
+	SortedXorList& operator=(const SortedXorList&) = delete;
+
+	~SortedXorList();
+
+	const_iterator insert_sorted(const_reference value);
+
+	const_iterator lower_bound(const_reference key) const;
+	const_iterator upper_bound(const_reference key) const;
+
+	// erases every element equivalent to key, returns how many were erased
+	size_type erase(const_reference key);
+
+	void clear();
+
+	size_type size() const noexcept { return items.size(); }
+	bool empty() const noexcept { return items.empty(); }
+
+	const_iterator begin() const noexcept { return items.begin(); }
+	const_iterator end() const noexcept { return items.end(); }
+
+	const list_type& list() const noexcept { return items; }
+
+private:
+	struct Finger
+	{
+		const_iterator position;
+		std::vector<Finger*> next;
+	};
+
+	// fills update with the last finger before the key on every level
+	// and returns the first position the comparison stops at
+	template <class Before>
+	const_iterator search(const_reference key, Before before, Finger** const update) const;
+
+	std::size_t random_levels();
+
+private:
+	list_type items;
+	Compare comp;
+
+	// header of the skip levels, fingers[l] is the first finger on level l
+	mutable Finger header;
+	std::size_t levels;
+	std::uint32_t seed;
+};
+
+#include "SortedXorList-inl.hpp"
+
+#endif /* _SORTED_XOR_LIST_H_ */
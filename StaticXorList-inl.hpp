@@ -0,0 +1,303 @@
+#include "StaticXorList.hpp"
+#include <stdexcept>
+
+template <class T, std::size_t Capacity>
+constexpr typename StaticXorList<T, Capacity>::const_iterator& StaticXorList<T, Capacity>::const_iterator::operator++()
+{
+	auto next = list->next_of(previous, current);
+	previous = current;
+	current = next;
+	return *this;
+}
+
+template <class T, std::size_t Capacity>
+constexpr typename StaticXorList<T, Capacity>::const_iterator StaticXorList<T, Capacity>::const_iterator::operator++(int)
+{
+	auto tmp = *this;
+	++(*this);
+	return tmp;
+}
+
+template <class T, std::size_t Capacity>
+constexpr typename StaticXorList<T, Capacity>::const_iterator& StaticXorList<T, Capacity>::const_iterator::operator--()
+{
+	auto before = list->next_of(current, previous);
+	current = previous;
+	previous = before;
+	return *this;
+}
+
+template <class T, std::size_t Capacity>
+constexpr typename StaticXorList<T, Capacity>::const_iterator StaticXorList<T, Capacity>::const_iterator::operator--(int)
+{
+	auto tmp = *this;
+	--(*this);
+	return tmp;
+}
+
+template <class T, std::size_t Capacity>
+constexpr StaticXorList<T, Capacity>::StaticXorList()
+	: slots()
+	, head(0)
+	, tail(0)
+	, _size(0)
+	, free_head(0)
+{
+	clear();
+}
+
+template <class T, std::size_t Capacity>
+constexpr StaticXorList<T, Capacity>::StaticXorList(std::initializer_list<T> il)
+	: StaticXorList()
+{
+	for (const auto& value : il)
+	{
+		push_back(value);
+	}
+}
+
+template <class T, std::size_t Capacity>
+constexpr typename StaticXorList<T, Capacity>::size_type StaticXorList<T, Capacity>::allocate_slot()
+{
+	// running out of slots is not a constant expression, so it fails the build
+	// and throws at run time
+	if (free_head == 0)
+	{
+		throw std::length_error("StaticXorList capacity exceeded");
+	}
+
+	auto index = free_head;
+	free_head = slots[index - 1].link;
+	slots[index - 1].link = 0;
+	++_size;
+	return index;
+}
+
+template <class T, std::size_t Capacity>
+constexpr void StaticXorList<T, Capacity>::free_slot(const size_type index)
+{
+	slots[index - 1].data = T();
+	slots[index - 1].link = free_head;
+	free_head = index;
+	--_size;
+}
+
+template <class T, std::size_t Capacity>
+constexpr void StaticXorList<T, Capacity>::push_back(const T& value)
+{
+	auto index = allocate_slot();
+	slots[index - 1].data = value;
+	slots[index - 1].link = tail;
+	if (tail == 0)
+	{
+		head = index;
+	}
+	else
+	{
+		slots[tail - 1].link ^= index;
+	}
+	tail = index;
+}
+
+template <class T, std::size_t Capacity>
+constexpr void StaticXorList<T, Capacity>::push_front(const T& value)
+{
+	auto index = allocate_slot();
+	slots[index - 1].data = value;
+	slots[index - 1].link = head;
+	if (head == 0)
+	{
+		tail = index;
+	}
+	else
+	{
+		slots[head - 1].link ^= index;
+	}
+	head = index;
+}
+
+template <class T, std::size_t Capacity>
+constexpr void StaticXorList<T, Capacity>::pop_front()
+{
+	auto index = head;
+	head = slots[index - 1].link;
+	if (head == 0)
+	{
+		tail = 0;
+	}
+	else
+	{
+		slots[head - 1].link ^= index;
+	}
+	free_slot(index);
+}
+
+template <class T, std::size_t Capacity>
+constexpr void StaticXorList<T, Capacity>::pop_back()
+{
+	auto index = tail;
+	tail = slots[index - 1].link;
+	if (tail == 0)
+	{
+		head = 0;
+	}
+	else
+	{
+		slots[tail - 1].link ^= index;
+	}
+	free_slot(index);
+}
+
+template <class T, std::size_t Capacity>
+constexpr void StaticXorList<T, Capacity>::clear()
+{
+	for (size_type i = 0; i < Capacity; ++i)
+	{
+		slots[i].data = T();
+		slots[i].link = (i + 1 < Capacity) ? i + 2 : 0;
+	}
+	free_head = 1;
+	head = tail = 0;
+	_size = 0;
+}
+
+template <class T, std::size_t Capacity>
+constexpr void StaticXorList<T, Capacity>::collect(size_type* const order) const
+{
+	size_type previous = 0;
+	size_type n = 0;
+	for (auto current = head; current != 0;)
+	{
+		order[n++] = current;
+		auto next = next_of(previous, current);
+		previous = current;
+		current = next;
+	}
+}
+
+template <class T, std::size_t Capacity>
+constexpr void StaticXorList<T, Capacity>::relink(const size_type* const order, const size_type n)
+{
+	for (size_type i = 0; i < n; ++i)
+	{
+		auto previous = (i > 0) ? order[i - 1] : 0;
+		auto next = (i + 1 < n) ? order[i + 1] : 0;
+		slots[order[i] - 1].link = previous ^ next;
+	}
+	head = (n > 0) ? order[0] : 0;
+	tail = (n > 0) ? order[n - 1] : 0;
+}
+
+template <class T, std::size_t Capacity>
+template <class Compare>
+constexpr void StaticXorList<T, Capacity>::sort(Compare comp)
+{
+	size_type order[Capacity] = {};
+	size_type scratch[Capacity] = {};
+	collect(order);
+
+	auto from = order;
+	auto to = scratch;
+	for (size_type width = 1; width < _size; width *= 2)
+	{
+		for (size_type first = 0; first < _size; first += 2 * width)
+		{
+			auto middle = (first + width < _size) ? first + width : _size;
+			auto last = (first + 2 * width < _size) ? first + 2 * width : _size;
+			auto i = first;
+			auto j = middle;
+			auto k = first;
+			while (i < middle && j < last)
+			{
+				// take from the left run on ties to stay stable
+				if (comp(slots[from[j] - 1].data, slots[from[i] - 1].data))
+				{
+					to[k++] = from[j++];
+				}
+				else
+				{
+					to[k++] = from[i++];
+				}
+			}
+			while (i < middle)
+			{
+				to[k++] = from[i++];
+			}
+			while (j < last)
+			{
+				to[k++] = from[j++];
+			}
+		}
+
+		auto tmp = from;
+		from = to;
+		to = tmp;
+	}
+
+	relink(from, _size);
+}
+
+template <class T, std::size_t Capacity>
+template <std::size_t OtherCapacity, class Compare>
+constexpr void StaticXorList<T, Capacity>::merge(StaticXorList<T, OtherCapacity>& x, Compare comp)
+{
+	if (static_cast<const void*>(&x) == static_cast<const void*>(this))
+	{
+		return;
+	}
+
+	// checked up front, so allocate_slot can't throw once x is being emptied
+	if (x.size() > Capacity - _size)
+	{
+		throw std::length_error("StaticXorList capacity exceeded");
+	}
+
+	size_type mine[Capacity] = {};
+	size_type order[Capacity] = {};
+	const auto mine_size = _size;
+	collect(mine);
+
+	size_type i = 0;
+	size_type n = 0;
+	while (!x.empty())
+	{
+		if (i < mine_size && !comp(x.front(), slots[mine[i] - 1].data))
+		{
+			order[n++] = mine[i++];
+			continue;
+		}
+
+		auto index = allocate_slot();
+		slots[index - 1].data = x.front();
+		order[n++] = index;
+		x.pop_front();
+	}
+	while (i < mine_size)
+	{
+		order[n++] = mine[i++];
+	}
+
+	relink(order, n);
+}
+
+template <class T, std::size_t Capacity>
+template <class BinaryPredicate>
+constexpr void StaticXorList<T, Capacity>::unique(BinaryPredicate binary_pred)
+{
+	size_type order[Capacity] = {};
+	const auto n = _size;
+	collect(order);
+
+	size_type kept = 0;
+	for (size_type i = 0; i < n; ++i)
+	{
+		if (kept > 0 && binary_pred(slots[order[kept - 1] - 1].data, slots[order[i] - 1].data))
+		{
+			free_slot(order[i]);
+			continue;
+		}
+		order[kept++] = order[i];
+	}
+
+	relink(order, kept);
+}
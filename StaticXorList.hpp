@@ -0,0 +1,147 @@
+#ifndef _STATIC_XOR_LIST_H_
+#define _STATIC_XOR_LIST_H_
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+
+/*
+	Fixed capacity XOR list usable in constant expressions
+	Links are XOR of 1-based slot indices instead of addresses (0 means null),
+	so no reinterpret_cast is needed and tables can be built at compile time:
+
+		constexpr auto table = [] {
+			StaticXorList<int, 8> t = { 3, 1, 2 };
+			t.sort();
+			return t;
+		}();
+
+	T must be a literal type with a default constructor
+*/
+
+template <class T, std::size_t Capacity>
+class StaticXorList
+{
+	static_assert(Capacity > 0, "StaticXorList needs at least one slot");
+
+public:
+	using value_type = T;
+	using size_type = std::size_t;
+	using reference = T&;
+	using const_reference = const T&;
+
+	class const_iterator
+	{
+	public:
+		using iterator_category = std::bidirectional_iterator_tag;
+		using value_type = T;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const T*;
+		using reference = const T&;
+
+	public:
+		constexpr const_iterator() : list(nullptr), previous(0), current(0) {}
+
+		constexpr reference operator*() const { return list->slots[current - 1].data; }
+		constexpr pointer operator->() const { return &list->slots[current - 1].data; }
+
+		constexpr const_iterator& operator++();
+		constexpr const_iterator operator++(int);
+		constexpr const_iterator& operator--();
+		constexpr const_iterator operator--(int);
+
+		constexpr bool operator==(const const_iterator& rhs) const { return current == rhs.current; }
+		constexpr bool operator!=(const const_iterator& rhs) const { return !(*this == rhs); }
+
+	private:
+		friend StaticXorList;
+
+		constexpr const_iterator(const StaticXorList* const _list, const size_type _current, const size_type _previous)
+			: list(_list)
+			, previous(_previous)
+			, current(_current)
+		{}
+
+	private:
+		const StaticXorList* list;
+		size_type previous;
+		size_type current;
+	};
+
+public:
+	constexpr StaticXorList();
+	constexpr StaticXorList(std::initializer_list<T> il);
+
+	constexpr void push_back(const T& value);
+	constexpr void push_front(const T& value);
+
+	constexpr void pop_front();
+	constexpr void pop_back();
+
+	constexpr void clear();
+
+	constexpr size_type size() const noexcept { return _size; }
+	constexpr bool empty() const noexcept { return _size == 0; }
+	static constexpr size_type capacity() noexcept { return Capacity; }
+
+	constexpr reference front() { return slots[head - 1].data; }
+	constexpr const_reference front() const { return slots[head - 1].data; }
+
+	constexpr reference back() { return slots[tail - 1].data; }
+	constexpr const_reference back() const { return slots[tail - 1].data; }
+
+	constexpr const_iterator begin() const noexcept { return const_iterator(this, head, 0); }
+	constexpr const_iterator end() const noexcept { return const_iterator(this, 0, tail); }
+
+	// stable bottom-up merge sort over slot indices
+	constexpr void sort() { sort(std::less<T>()); }
+
+	template <class Compare>
+	constexpr void sort(Compare comp);
+
+	// both lists must be sorted, x is left empty
+	// throws std::length_error and changes neither list if the elements of x don't fit
+	template <std::size_t OtherCapacity>
+	constexpr void merge(StaticXorList<T, OtherCapacity>& x) { merge(x, std::less<T>()); }
+
+	template <std::size_t OtherCapacity, class Compare>
+	constexpr void merge(StaticXorList<T, OtherCapacity>& x, Compare comp);
+
+	constexpr void unique() { unique(std::equal_to<T>()); }
+
+	template <class BinaryPredicate>
+	constexpr void unique(BinaryPredicate binary_pred);
+
+private:
+	template <class U, std::size_t OtherCapacity>
+	friend class StaticXorList;
+
+	struct Slot
+	{
+		T data;
+		size_type link; /* XOR of next and previous slot index, or next free slot */
+	};
+
+	constexpr size_type allocate_slot();
+	constexpr void free_slot(const size_type index);
+
+	constexpr size_type next_of(const size_type previous, const size_type current) const { return slots[current - 1].link ^ previous; }
+
+	// fills order with the slot indices in list order
+	constexpr void collect(size_type* const order) const;
+
+	// rebuilds every link from order
+	constexpr void relink(const size_type* const order, const size_type n);
+
+private:
+	Slot slots[Capacity];
+	size_type head;
+	size_type tail;
+	size_type _size;
+	size_type free_head;
+};
+
+#include "StaticXorList-inl.hpp"
+
+#endif /* _STATIC_XOR_LIST_H_ */
@@ -0,0 +1,189 @@
+#include "XorChannel.hpp"
+#include <cassert>
+#include <utility>
+
+template <class T, class TAllocator>
+XorChannel<T, TAllocator>::XorChannel(const size_type capacity)
+	: items()
+	, _capacity(capacity)
+	, _closed(false)
+{
+	assert(capacity > 0);
+}
+
+template <class T, class TAllocator>
+bool XorChannel<T, TAllocator>::push(const T& value) { return push_value(value, true); }
+
+template <class T, class TAllocator>
+bool XorChannel<T, TAllocator>::push(T&& value) { return push_value(std::move(value), true); }
+
+template <class T, class TAllocator>
+bool XorChannel<T, TAllocator>::try_push(const T& value) { return push_value(value, false); }
+
+template <class T, class TAllocator>
+bool XorChannel<T, TAllocator>::try_push(T&& value) { return push_value(std::move(value), false); }
+
+template <class T, class TAllocator>
+template <class U>
+bool XorChannel<T, TAllocator>::push_value(U&& value, const bool wait)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	if (wait)
+	{
+		not_full.wait(lock, [this] { return _closed || items.size() < _capacity; });
+	}
+
+	if (_closed || items.size() >= _capacity)
+	{
+		return false;
+	}
+
+#ifdef XOR_CHANNEL_COROUTINES
+	if (!awaiters.empty())
+	{
+		// hand the value straight to a suspended consumer
+		auto awaiter = awaiters.front();
+		awaiters.pop_front();
+		awaiter->value.emplace(std::forward<U>(value));
+		lock.unlock();
+		awaiter->handle.resume();
+		return true;
+	}
+#endif
+
+	items.push_back(std::forward<U>(value));
+	lock.unlock();
+	not_empty.notify_one();
+	return true;
+}
+
+template <class T, class TAllocator>
+void XorChannel<T, TAllocator>::take_front(T& value)
+{
+	value = std::move(items.front());
+	items.pop_front();
+}
+
+template <class T, class TAllocator>
+bool XorChannel<T, TAllocator>::pop(T& value)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	not_empty.wait(lock, [this] { return _closed || !items.empty(); });
+	if (items.empty())
+	{
+		return false;
+	}
+
+	take_front(value);
+	lock.unlock();
+	not_full.notify_one();
+	return true;
+}
+
+template <class T, class TAllocator>
+bool XorChannel<T, TAllocator>::try_pop(T& value)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	if (items.empty())
+	{
+		return false;
+	}
+
+	take_front(value);
+	lock.unlock();
+	not_full.notify_one();
+	return true;
+}
+
+template <class T, class TAllocator>
+typename XorChannel<T, TAllocator>::list_type XorChannel<T, TAllocator>::pop_n(const size_type n)
+{
+	if (n == 0)
+	{
+		return list_type();
+	}
+
+	std::unique_lock<std::mutex> lock(mutex);
+	not_empty.wait(lock, [this] { return _closed || !items.empty(); });
+	auto result = items.pop_front_n(n);
+	lock.unlock();
+	not_full.notify_all();
+	return result;
+}
+
+template <class T, class TAllocator>
+void XorChannel<T, TAllocator>::close()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	_closed = true;
+
+#ifdef XOR_CHANNEL_COROUTINES
+	LinkedList<PopAwaiter*> waiting;
+	waiting.swap(awaiters);
+	lock.unlock();
+	for (auto awaiter : waiting)
+	{
+		awaiter->handle.resume();
+	}
+#else
+	lock.unlock();
+#endif
+
+	not_empty.notify_all();
+	not_full.notify_all();
+}
+
+template <class T, class TAllocator>
+bool XorChannel<T, TAllocator>::closed() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return _closed;
+}
+
+template <class T, class TAllocator>
+typename XorChannel<T, TAllocator>::size_type XorChannel<T, TAllocator>::size() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return items.size();
+}
+
+#ifdef XOR_CHANNEL_COROUTINES
+template <class T, class TAllocator>
+bool XorChannel<T, TAllocator>::try_pop_awaiter(PopAwaiter& awaiter)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	if (items.empty())
+	{
+		return _closed;
+	}
+
+	awaiter.value.emplace(std::move(items.front()));
+	items.pop_front();
+	lock.unlock();
+	not_full.notify_one();
+	return true;
+}
+
+template <class T, class TAllocator>
+bool XorChannel<T, TAllocator>::PopAwaiter::await_suspend(std::coroutine_handle<> _handle)
+{
+	std::unique_lock<std::mutex> lock(channel->mutex);
+	if (!channel->items.empty())
+	{
+		value.emplace(std::move(channel->items.front()));
+		channel->items.pop_front();
+		lock.unlock();
+		channel->not_full.notify_one();
+		return false;
+	}
+
+	if (channel->_closed)
+	{
+		return false;
+	}
+
+	handle = _handle;
+	channel->awaiters.push_back(this);
+	return true;
+}
+#endif
@@ -0,0 +1,113 @@
+#ifndef _XOR_CHANNEL_H_
+#define _XOR_CHANNEL_H_
+
+#include "LinkedList.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <limits>
+#include <mutex>
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define XOR_CHANNEL_COROUTINES 1
+#include <coroutine>
+#include <optional>
+#endif
+#endif
+
+/*
+	Bounded multi-producer multi-consumer queue over LinkedList
+	Producers block while the channel is full, consumers block while it is empty
+	After close() pushes fail and pops drain what is left, then fail
+*/
+
+template < class T, class TAllocator = std::allocator<T> >
+class XorChannel
+{
+public:
+	using list_type = LinkedList<T, TAllocator>;
+	using value_type = T;
+	using size_type = typename list_type::size_type;
+
+public:
+	explicit XorChannel(const size_type capacity = std::numeric_limits<size_type>::max());
+
+	XorChannel(const XorChannel&) = delete;
+	XorChannel& operator=(const XorChannel&) = delete;
+
+	// false if the channel is closed
+	bool push(const T& value);
+	bool push(T&& value);
+
+	// false if the channel is full or closed
+	bool try_push(const T& value);
+	bool try_push(T&& value);
+
+	// false once the channel is closed and drained
+	bool pop(T& value);
+
+	// false if the channel is empty
+	bool try_pop(T& value);
+
+	// waits for at least one element and takes up to n of them in one locked step
+	// an empty result means the channel is closed and drained
+	list_type pop_n(const size_type n);
+
+	void close();
+	bool closed() const;
+
+	size_type size() const;
+	size_type capacity() const noexcept { return _capacity; }
+
+#ifdef XOR_CHANNEL_COROUTINES
+	class PopAwaiter
+	{
+	public:
+		explicit PopAwaiter(XorChannel* const _channel) : channel(_channel) {}
+
+		bool await_ready() { return channel->try_pop_awaiter(*this); }
+		bool await_suspend(std::coroutine_handle<> _handle);
+
+		// empty once the channel is closed and drained
+		std::optional<T> await_resume() { return std::move(value); }
+
+	private:
+		friend XorChannel;
+
+		XorChannel* channel;
+		std::optional<T> value;
+		std::coroutine_handle<> handle;
+	};
+
+	// co_await channel.async_pop() suspends instead of blocking the thread
+	// the coroutine is resumed on the thread that pushes the value or closes the channel
+	PopAwaiter async_pop() { return PopAwaiter(this); }
+#endif
+
+private:
+	template <class U>
+	bool push_value(U&& value, const bool wait);
+
+	void take_front(T& value);
+
+#ifdef XOR_CHANNEL_COROUTINES
+	bool try_pop_awaiter(PopAwaiter& awaiter);
+#endif
+
+private:
+	mutable std::mutex mutex;
+	std::condition_variable not_empty;
+	std::condition_variable not_full;
+
+	list_type items;
+	size_type _capacity;
+	bool _closed;
+
+#ifdef XOR_CHANNEL_COROUTINES
+	LinkedList<PopAwaiter*> awaiters;
+#endif
+};
+
+#include "XorChannel-inl.hpp"
+
+#endif /* _XOR_CHANNEL_H_ */
@@ -0,0 +1,181 @@
+#include "XorLinkedHashMap.hpp"
+
+template <class K, class V, class Hash, class KeyEqual, class TAllocator>
+XorLinkedHashMap<K, V, Hash, KeyEqual, TAllocator>::XorLinkedHashMap(const size_type bucket_count, const Hash& hash,
+	const KeyEqual& equal, const TAllocator& alloc)
+	: entries(bucket_count, hash, equal, typename map_type::allocator_type(alloc))
+	, first(nullptr)
+	, last(nullptr)
+{}
+
+template <class K, class V, class Hash, class KeyEqual, class TAllocator>
+typename XorLinkedHashMap<K, V, Hash, KeyEqual, TAllocator>::entry_type*
+XorLinkedHashMap<K, V, Hash, KeyEqual, TAllocator>::next_of(const entry_type* const entry) noexcept
+{
+	return reinterpret_cast<entry_type*>(entry->second.link ^ reinterpret_cast<intptr_t>(entry->second.previous));
+}
+
+template <class K, class V, class Hash, class KeyEqual, class TAllocator>
+void XorLinkedHashMap<K, V, Hash, KeyEqual, TAllocator>::link_front(entry_type* const entry) noexcept
+{
+	entry->second.previous = nullptr;
+	entry->second.link = reinterpret_cast<intptr_t>(first);
+
+	// the old front now has the new entry before it
+	if (nullptr != first)
+	{
+		first->second.link ^= reinterpret_cast<intptr_t>(entry);
+		first->second.previous = entry;
+	}
+	else
+	{
+		last = entry;
+	}
+	first = entry;
+}
+
+template <class K, class V, class Hash, class KeyEqual, class TAllocator>
+void XorLinkedHashMap<K, V, Hash, KeyEqual, TAllocator>::unlink(entry_type* const entry) noexcept
+{
+	auto previous = entry->second.previous;
+	auto next = next_of(entry);
+	const auto bypass = reinterpret_cast<intptr_t>(entry);
+
+	if (nullptr != previous)
+	{
+		previous->second.link ^= bypass ^ reinterpret_cast<intptr_t>(next);
+	}
+	else
+	{
+		first = next;
+	}
+
+	if (nullptr != next)
+	{
+		next->second.link ^= bypass ^ reinterpret_cast<intptr_t>(previous);
+		next->second.previous = previous;
+	}
+	else
+	{
+		last = previous;
+	}
+}
+
+template <class K, class V, class Hash, class KeyEqual, class TAllocator>
+void XorLinkedHashMap<K, V, Hash, KeyEqual, TAllocator>::move_to_front(entry_type* const entry) noexcept
+{
+	if (first != entry)
+	{
+		unlink(entry);
+		link_front(entry);
+	}
+}
+
+template <class K, class V, class Hash, class KeyEqual, class TAllocator>
+template <class M>
+bool XorLinkedHashMap<K, V, Hash, KeyEqual, TAllocator>::put(const K& key, M&& value)
+{
+	auto found = entries.find(key);
+	if (found != entries.end())
+	{
+		found->second.value = std::forward<M>(value);
+		move_to_front(&*found);
+		return false;
+	}
+
+	auto inserted = entries.emplace(std::piecewise_construct, std::forward_as_tuple(key),
+		std::forward_as_tuple(std::forward<M>(value))).first;
+	link_front(&*inserted);
+	return true;
+}
+
+template <class K, class V, class Hash, class KeyEqual, class TAllocator>
+V* XorLinkedHashMap<K, V, Hash, KeyEqual, TAllocator>::get(const K& key)
+{
+	auto found = entries.find(key);
+	if (found == entries.end())
+	{
+		return nullptr;
+	}
+
+	move_to_front(&*found);
+	return &found->second.value;
+}
+
+template <class K, class V, class Hash, class KeyEqual, class TAllocator>
+V* XorLinkedHashMap<K, V, Hash, KeyEqual, TAllocator>::find(const K& key)
+{
+	auto found = entries.find(key);
+	return found == entries.end() ? nullptr : &found->second.value;
+}
+
+template <class K, class V, class Hash, class KeyEqual, class TAllocator>
+const V* XorLinkedHashMap<K, V, Hash, KeyEqual, TAllocator>::find(const K& key) const
+{
+	auto found = entries.find(key);
+	return found == entries.end() ? nullptr : &found->second.value;
+}
+
+template <class K, class V, class Hash, class KeyEqual, class TAllocator>
+bool XorLinkedHashMap<K, V, Hash, KeyEqual, TAllocator>::touch(const K& key)
+{
+	return nullptr != get(key);
+}
+
+template <class K, class V, class Hash, class KeyEqual, class TAllocator>
+bool XorLinkedHashMap<K, V, Hash, KeyEqual, TAllocator>::erase(const K& key)
+{
+	auto found = entries.find(key);
+	if (found == entries.end())
+	{
+		return false;
+	}
+
+	unlink(&*found);
+	entries.erase(found);
+	return true;
+}
+
+template <class K, class V, class Hash, class KeyEqual, class TAllocator>
+bool XorLinkedHashMap<K, V, Hash, KeyEqual, TAllocator>::evict_back()
+{
+	return evict_back([](const K&, V&&) {});
+}
+
+template <class K, class V, class Hash, class KeyEqual, class TAllocator>
+template <class F>
+bool XorLinkedHashMap<K, V, Hash, KeyEqual, TAllocator>::evict_back(F&& on_evict)
+{
+	if (nullptr == last)
+	{
+		return false;
+	}
+
+	auto entry = last;
+	on_evict(entry->first, std::move(entry->second.value));
+	unlink(entry);
+	entries.erase(entry->first);
+	return true;
+}
+
+template <class K, class V, class Hash, class KeyEqual, class TAllocator>
+template <class F>
+void XorLinkedHashMap<K, V, Hash, KeyEqual, TAllocator>::for_each(F&& f) const
+{
+	// plain XOR walk, the stored previous isn't needed from the front
+	const entry_type* previous = nullptr;
+	for (auto entry = first; nullptr != entry;)
+	{
+		f(entry->first, entry->second.value);
+		auto next = reinterpret_cast<entry_type*>(entry->second.link ^ reinterpret_cast<intptr_t>(previous));
+		previous = entry;
+		entry = next;
+	}
+}
+
+template <class K, class V, class Hash, class KeyEqual, class TAllocator>
+void XorLinkedHashMap<K, V, Hash, KeyEqual, TAllocator>::clear()
+{
+	entries.clear();
+	first = last = nullptr;
+}
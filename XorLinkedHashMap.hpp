@@ -0,0 +1,104 @@
+#ifndef _XOR_LINKED_HASH_MAP_H_
+#define _XOR_LINKED_HASH_MAP_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+/*
+	Hash map that keeps its entries in recency order, most recently put or touched first
+	The order runs through the map nodes themselves: every entry holds the address of the previous
+	entry and the XOR of both neighbours, so an entry found by key is unlinked in O(1)
+	That is two words per entry, as many as a doubly linked list, the XOR saves nothing here;
+	what is saved against std::list + std::unordered_map is the separate list node and its allocation
+*/
+
+template < class K, class V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>,
+	class TAllocator = std::allocator<std::pair<const K, V>> >
+class XorLinkedHashMap
+{
+public:
+	using key_type = K;
+	using mapped_type = V;
+	using size_type = std::size_t;
+
+private:
+	struct Slot;
+	using entry_type = std::pair<const K, Slot>;
+	using map_type = std::unordered_map<K, Slot, Hash, KeyEqual,
+		typename std::allocator_traits<TAllocator>::template rebind_alloc<entry_type>>;
+
+	struct Slot
+	{
+		template <class... Args>
+		explicit Slot(Args&&... args) : value(std::forward<Args>(args)...), previous(nullptr), link(0) {}
+
+		V value;
+		entry_type* previous; /* nullptr at the front */
+		intptr_t link; /* XOR of the previous and the next entry */
+	};
+
+public:
+	explicit XorLinkedHashMap(size_type bucket_count = 0, const Hash& hash = Hash(),
+		const KeyEqual& equal = KeyEqual(), const TAllocator& alloc = TAllocator());
+
+	XorLinkedHashMap(const XorLinkedHashMap&) = delete;
+	XorLinkedHashMap& operator=(const XorLinkedHashMap&) = delete;
+
+	// inserts at the front or assigns to an existing key and moves it to the front
+	// returns true if the key was inserted
+	template <class M>
+	bool put(const K& key, M&& value);
+
+	// moves the entry to the front, nullptr if there is no such key
+	V* get(const K& key);
+
+	// looks up without changing the order
+	V* find(const K& key);
+	const V* find(const K& key) const;
+
+	// moves the entry to the front, returns false if there is no such key
+	bool touch(const K& key);
+
+	bool erase(const K& key);
+
+	// removes the least recently used entry, returns false if the map is empty
+	bool evict_back();
+
+	// calls on_evict(key, value) before removing the least recently used entry
+	template <class F>
+	bool evict_back(F&& on_evict);
+
+	// calls f(key, value) from the front to the back
+	template <class F>
+	void for_each(F&& f) const;
+
+	const K& front_key() const { return first->first; }
+	const K& back_key() const { return last->first; }
+
+	void clear();
+	void reserve(size_type n) { entries.reserve(n); }
+
+	size_type size() const noexcept { return entries.size(); }
+	bool empty() const noexcept { return entries.empty(); }
+
+private:
+	void link_front(entry_type* entry) noexcept;
+	void unlink(entry_type* entry) noexcept;
+	void move_to_front(entry_type* entry) noexcept;
+
+	static entry_type* next_of(const entry_type* entry) noexcept;
+
+private:
+	map_type entries;
+	entry_type* first;
+	entry_type* last;
+};
+
+#include "XorLinkedHashMap-inl.hpp"
+
+#endif /* _XOR_LINKED_HASH_MAP_H_ */
@@ -0,0 +1,65 @@
+#ifndef _XOR_RELINK_H_
+#define _XOR_RELINK_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/*
+	Batched rebuild of XOR links
+	addresses[1..n] are the nodes in list order, addresses[0] and addresses[n + 1]
+	their outer neighbours or 0; the link of node i, stored link_offset bytes into it,
+	becomes addresses[i - 1] ^ addresses[i + 1]
+	The XORs are computed in vector registers when the build enables AVX2 or AVX-512,
+	AVX-512 also scatters the results straight into the nodes
+*/
+
+namespace
+{
+	inline void store_link(const intptr_t node, const std::size_t link_offset, const intptr_t link) noexcept
+	{
+		*reinterpret_cast<intptr_t*>(node + static_cast<intptr_t>(link_offset)) = link;
+	}
+
+	inline void xor_relink_scalar(const intptr_t* const addresses, const std::size_t n, const std::size_t link_offset) noexcept
+	{
+		for (std::size_t i = 1; i <= n; ++i)
+		{
+			store_link(addresses[i], link_offset, addresses[i - 1] ^ addresses[i + 1]);
+		}
+	}
+
+	inline void xor_relink(const intptr_t* const addresses, const std::size_t n, const std::size_t link_offset) noexcept
+	{
+		const std::size_t end = n + 1;
+		std::size_t i = 1;
+#if defined(__AVX512F__)
+		const __m512i offset = _mm512_set1_epi64(static_cast<long long>(link_offset));
+		for (; end - i >= 8; i += 8)
+		{
+			__m512i before = _mm512_loadu_si512(addresses + i - 1);
+			__m512i after = _mm512_loadu_si512(addresses + i + 1);
+			__m512i where = _mm512_add_epi64(_mm512_loadu_si512(addresses + i), offset);
+			_mm512_i64scatter_epi64(nullptr, where, _mm512_xor_si512(before, after), 1);
+		}
+#elif defined(__AVX2__)
+		alignas(32) intptr_t links[4];
+		for (; end - i >= 4; i += 4)
+		{
+			__m256i before = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(addresses + i - 1));
+			__m256i after = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(addresses + i + 1));
+			_mm256_store_si256(reinterpret_cast<__m256i*>(links), _mm256_xor_si256(before, after));
+			store_link(addresses[i], link_offset, links[0]);
+			store_link(addresses[i + 1], link_offset, links[1]);
+			store_link(addresses[i + 2], link_offset, links[2]);
+			store_link(addresses[i + 3], link_offset, links[3]);
+		}
+#endif
+		xor_relink_scalar(addresses + (i - 1), end - i, link_offset);
+	}
+}
+
+#endif /* _XOR_RELINK_H_ */
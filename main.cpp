@@ -1,8 +1,22 @@
 #include "LinkedListTest.hpp"
+#include "LinkedListFuzzTest.hpp"
+#include "LinkedListBenchmark.hpp"
+#include <cstring>
 
-int main()
+int main(int argc, char* argv[])
 {
 	LinkedListTest::run();
+	LinkedListFuzzTest::run();
+
+	if (argc > 1 && std::strcmp(argv[1], "stress") == 0)
+	{
+		LinkedListFuzzTest::stress();
+	}
+
+	if (argc > 1 && std::strcmp(argv[1], "bench") == 0)
+	{
+		LinkedListBenchmark::run();
+	}
 
 	return 0;
 }